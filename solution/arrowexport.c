@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include "arrowexport.h"
+
+// Define struct for everything an exported schema owns, freed as one block
+typedef struct
+{
+    struct ArrowSchema children[3];
+    struct ArrowSchema *childPointers[3];
+} ArrowSchemaExport;
+
+// Define struct for everything an exported array owns, followed in the same block by the columns
+typedef struct
+{
+    struct ArrowArray children[3];
+    struct ArrowArray *childPointers[3];
+    const void *structBuffers[1];
+    const void *typeBuffers[2];
+    const void *severityBuffers[2];
+    const void *descriptionBuffers[3];
+    int references; // the parent array and every child that has not been released
+} ArrowArrayExport;
+
+/*
+This helper releases a child of an exported schema. A schema child only points to string
+literals, so it is just marked as released.
+*/
+static void releaseArrowSchemaChild(struct ArrowSchema *schema)
+{
+    schema->release = NULL;
+}
+
+/*
+This helper drops one reference to the block of an exported array and frees the block once the
+parent and every child have been released. Consumers may move a child out and keep it after the
+parent is released, so the columns have to live as long as the last of them.
+*/
+static void releaseArrowArrayBlock(ArrowArrayExport *arrayExport)
+{
+    if (__atomic_sub_fetch(&arrayExport->references, 1, __ATOMIC_ACQ_REL) == 0)
+    {
+        free(arrayExport);
+    }
+}
+
+/*
+This helper releases a column of an exported array.
+*/
+static void releaseArrowArrayChild(struct ArrowArray *array)
+{
+    releaseArrowArrayBlock((ArrowArrayExport *)array->private_data);
+    array->release = NULL;
+}
+
+/*
+This helper releases an exported schema: the children that were not moved out are released,
+then the block holding them is freed.
+*/
+static void releaseArrowSchema(struct ArrowSchema *schema)
+{
+    for (int i = 0; i < schema->n_children; i++)
+    {
+        if (schema->children[i]->release != NULL)
+        {
+            schema->children[i]->release(schema->children[i]);
+        }
+    }
+    free(schema->private_data);
+    schema->release = NULL;
+}
+
+/*
+This helper releases an exported array: the children that were not moved out are released,
+then the reference of the parent to the block holding the columns is dropped.
+*/
+static void releaseArrowArray(struct ArrowArray *array)
+{
+    for (int i = 0; i < array->n_children; i++)
+    {
+        if (array->children[i]->release != NULL)
+        {
+            array->children[i]->release(array->children[i]);
+        }
+    }
+    releaseArrowArrayBlock((ArrowArrayExport *)array->private_data);
+    array->release = NULL;
+}
+
+/*
+This helper fills in the schema of one non-nullable column.
+*/
+static void initArrowSchemaChild(struct ArrowSchema *child, const char *format, const char *name)
+{
+    memset(child, 0, sizeof(struct ArrowSchema));
+    child->format = format;
+    child->name = name;
+    child->release = releaseArrowSchemaChild;
+}
+
+/*
+This helper fills in one column of an exported array without nulls.
+*/
+static void initArrowArrayChild(struct ArrowArray *child, ArrowArrayExport *arrayExport, int64_t length, const void **buffers, int64_t numBuffers)
+{
+    memset(child, 0, sizeof(struct ArrowArray));
+    child->length = length;
+    child->n_buffers = numBuffers;
+    child->buffers = buffers;
+    child->release = releaseArrowArrayChild;
+    child->private_data = arrayExport;
+}
+
+/*
+This function exports the incidents of a management system through the Arrow C Data Interface,
+as a struct array with an int32 "type" column, an int32 "severity" column and a utf8
+"description" column, none of which has nulls. Arrow columns must be contiguous, while the
+system stores whole incidents one after the other, so the columns are gathered in one pass into
+a single block. That block is freed once the array and every column moved out of it have been
+released, so the export stays valid after the system changes and can be handed to any Arrow
+consumer without a library dependency. Tombstoned incidents are left out of the export. It returns 0 on success and -1 if the memory could not
+be allocated, in which case neither struct is touched.
+*/
+int exportIncidentsToArrow(const ComplianceManagementSystem *system, struct ArrowSchema *schema, struct ArrowArray *array)
+{
+    int numIncidents = 0;
+    int32_t descriptionBytes = 0;
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        if (!isComplianceIncidentTombstoned(incident))
+        {
+            descriptionBytes += (int32_t)strnlen(incident->description, 100);
+            numIncidents++;
+        }
+    }
+
+    ArrowSchemaExport *schemaExport = (ArrowSchemaExport *)malloc(sizeof(ArrowSchemaExport));
+    size_t columnBytes = (2 * numIncidents + numIncidents + 1) * sizeof(int32_t) + descriptionBytes;
+    ArrowArrayExport *arrayExport = (ArrowArrayExport *)malloc(sizeof(ArrowArrayExport) + columnBytes);
+    if (schemaExport == NULL || arrayExport == NULL)
+    {
+        free(schemaExport);
+        free(arrayExport);
+        return -1;
+    }
+
+    // Gather the columns into the block right after the export struct
+    int32_t *types = (int32_t *)(arrayExport + 1);
+    int32_t *severities = types + numIncidents;
+    int32_t *offsets = severities + numIncidents;
+    char *descriptions = (char *)(offsets + numIncidents + 1);
+    offsets[0] = 0;
+    int row = 0;
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        if (isComplianceIncidentTombstoned(incident))
+        {
+            continue;
+        }
+        int32_t length = (int32_t)strnlen(incident->description, 100);
+        types[row] = (int32_t)incident->type;
+        severities[row] = (int32_t)incident->severity;
+        memcpy(descriptions + offsets[row], incident->description, length);
+        offsets[row + 1] = offsets[row] + length;
+        row++;
+    }
+
+    initArrowSchemaChild(&schemaExport->children[0], "i", "type");
+    initArrowSchemaChild(&schemaExport->children[1], "i", "severity");
+    initArrowSchemaChild(&schemaExport->children[2], "u", "description");
+    for (int i = 0; i < 3; i++)
+    {
+        schemaExport->childPointers[i] = &schemaExport->children[i];
+    }
+    memset(schema, 0, sizeof(struct ArrowSchema));
+    schema->format = "+s";
+    schema->name = "";
+    schema->n_children = 3;
+    schema->children = schemaExport->childPointers;
+    schema->release = releaseArrowSchema;
+    schema->private_data = schemaExport;
+
+    arrayExport->references = 4;
+    arrayExport->structBuffers[0] = NULL;
+    arrayExport->typeBuffers[0] = NULL;
+    arrayExport->typeBuffers[1] = types;
+    arrayExport->severityBuffers[0] = NULL;
+    arrayExport->severityBuffers[1] = severities;
+    arrayExport->descriptionBuffers[0] = NULL;
+    arrayExport->descriptionBuffers[1] = offsets;
+    arrayExport->descriptionBuffers[2] = descriptions;
+    initArrowArrayChild(&arrayExport->children[0], arrayExport, numIncidents, arrayExport->typeBuffers, 2);
+    initArrowArrayChild(&arrayExport->children[1], arrayExport, numIncidents, arrayExport->severityBuffers, 2);
+    initArrowArrayChild(&arrayExport->children[2], arrayExport, numIncidents, arrayExport->descriptionBuffers, 3);
+    for (int i = 0; i < 3; i++)
+    {
+        arrayExport->childPointers[i] = &arrayExport->children[i];
+    }
+    memset(array, 0, sizeof(struct ArrowArray));
+    array->length = numIncidents;
+    array->n_buffers = 1;
+    array->n_children = 3;
+    array->buffers = arrayExport->structBuffers;
+    array->children = arrayExport->childPointers;
+    array->release = releaseArrowArray;
+    array->private_data = arrayExport;
+    return 0;
+}
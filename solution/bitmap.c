@@ -1,5 +1,158 @@
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
 #include "bitmap.h"
 
+// Define struct for a registered mutation listener
+typedef struct
+{
+    ComplianceMutationListener listener;
+    void *context;
+} MutationListenerEntry;
+
+// Define struct for the listeners registered for one management system
+typedef struct
+{
+    ComplianceManagementSystem *system; // NULL for an empty slot
+    MutationListenerEntry entries[MAX_MUTATION_LISTENERS];
+    int numEntries;
+} MutationListenerSet;
+
+// Open addressing table from a management system to its listeners, guarded by mutationListenerLock
+static MutationListenerSet *mutationListenerSets = NULL;
+static int numMutationListenerSlots = 0;
+static int numMutationListenerSets = 0;
+static int numMutationListeners = 0;
+static pthread_rwlock_t mutationListenerLock = PTHREAD_RWLOCK_INITIALIZER;
+static unsigned long mutationSequence = 0;
+
+/*
+This helper returns the slot where the probe for a management system starts in the listener table.
+*/
+static int homeMutationListenerSlot(const ComplianceManagementSystem *system)
+{
+    return (int)((((uintptr_t)system >> 4) * 0x9E3779B97F4A7C15ULL >> 32) & (uintptr_t)(numMutationListenerSlots - 1));
+}
+
+/*
+This helper finds the slot of a management system in the listener table. It returns the slot
+holding the system, or the empty slot where it would go. The table must not be empty.
+*/
+static int findMutationListenerSlot(const ComplianceManagementSystem *system)
+{
+    int mask = numMutationListenerSlots - 1;
+    int slot = homeMutationListenerSlot(system);
+    while (mutationListenerSets[slot].system != NULL && mutationListenerSets[slot].system != system)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/*
+This helper doubles the listener table, or creates it with 16 slots, and reinserts every
+system. It returns 0 on success and -1 if the memory could not be allocated, in which case the
+table is left untouched. The caller must hold the write lock.
+*/
+static int growMutationListenerSets(void)
+{
+    int oldNumSlots = numMutationListenerSlots;
+    int newNumSlots = oldNumSlots > 0 ? oldNumSlots * 2 : 16;
+    MutationListenerSet *oldSets = mutationListenerSets;
+    MutationListenerSet *newSets = (MutationListenerSet *)calloc(newNumSlots, sizeof(MutationListenerSet));
+    if (newSets == NULL)
+    {
+        return -1;
+    }
+    mutationListenerSets = newSets;
+    numMutationListenerSlots = newNumSlots;
+    for (int slot = 0; slot < oldNumSlots; slot++)
+    {
+        if (oldSets[slot].system != NULL)
+        {
+            mutationListenerSets[findMutationListenerSlot(oldSets[slot].system)] = oldSets[slot];
+        }
+    }
+    free(oldSets);
+    return 0;
+}
+
+/*
+This helper empties the slot of a system that has no listeners left. The systems after it in
+the same probe run are moved back so that every system stays reachable from its home slot. The
+caller must hold the write lock.
+*/
+static void releaseMutationListenerSlot(int slot)
+{
+    int mask = numMutationListenerSlots - 1;
+    int hole = slot;
+    mutationListenerSets[hole].system = NULL;
+    for (int next = (hole + 1) & mask; mutationListenerSets[next].system != NULL; next = (next + 1) & mask)
+    {
+        int home = homeMutationListenerSlot(mutationListenerSets[next].system);
+        // Move the system into the hole unless its home slot lies cyclically between the hole and its slot
+        if ((next > hole && (home <= hole || home > next)) || (next < hole && home <= hole && home > next))
+        {
+            mutationListenerSets[hole] = mutationListenerSets[next];
+            mutationListenerSets[next].system = NULL;
+            hole = next;
+        }
+    }
+    numMutationListenerSets--;
+}
+
+/*
+This helper hands a mutation of a management system to every listener registered for
+that system. It is called by the functions that change the system, after an add or update
+has been stored, before a removal shifts the remaining incidents and before a tombstone negates
+the severity. The mutation sequence is
+advanced atomically, and when no listeners are registered anywhere nothing else is done.
+Listeners run under the read lock of the listener table, so they must not register or
+unregister listeners themselves.
+*/
+static void notifyComplianceMutation(ComplianceManagementSystem *system, ComplianceMutationKind kind, int index, int oldSeverity)
+{
+    unsigned long sequence = __atomic_add_fetch(&mutationSequence, 1, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&numMutationListeners, __ATOMIC_ACQUIRE) == 0)
+    {
+        return;
+    }
+    ComplianceMutation mutation;
+    mutation.kind = kind;
+    mutation.sequence = sequence;
+    mutation.index = index;
+    mutation.incident = &system->incidents[index].dataPrivacyIncident;
+    mutation.oldSeverity = oldSeverity;
+    pthread_rwlock_rdlock(&mutationListenerLock);
+    if (numMutationListenerSlots > 0)
+    {
+        const MutationListenerSet *set = &mutationListenerSets[findMutationListenerSlot(system)];
+        for (int i = 0; set->system == system && i < set->numEntries; i++)
+        {
+            set->entries[i].listener(set->entries[i].context, &mutation);
+        }
+    }
+    pthread_rwlock_unlock(&mutationListenerLock);
+}
+
+/*
+This helper tells the listeners of a management system that the incident at a position is about
+to be removed: a live incident is announced as INCIDENT_REMOVED, and a tombstoned one, which was
+already removed logically, as INCIDENT_COMPACTED.
+*/
+static void notifyComplianceRemoval(ComplianceManagementSystem *system, int index)
+{
+    const ComplianceIncident *incident = &system->incidents[index].dataPrivacyIncident;
+    if (isComplianceIncidentTombstoned(incident))
+    {
+        notifyComplianceMutation(system, INCIDENT_COMPACTED, index, 0);
+    }
+    else
+    {
+        notifyComplianceMutation(system, INCIDENT_REMOVED, index, incident->severity);
+    }
+}
+
 /*
 This function adds a compliance incident to a compliance management system.
 It checks if the system is not already full, if the incident type is valid,
@@ -54,6 +207,9 @@ void addComplianceIncident(ComplianceManagementSystem *system, ComplianceInciden
 
     // Increment the number of incidents in the system
     system->numIncidents++;
+
+    // Let the listeners of the system know about the new incident
+    notifyComplianceMutation(system, INCIDENT_ADDED, system->numIncidents - 1, 0);
 }
 
 /*
@@ -62,6 +218,7 @@ average severity of all incidents in the system. It first checks if there are an
 incidents in the system and returns 0 if there are none. Then, it loops through
 all incidents in the system and adds up the severity of each one based on its type.
 Finally, it calculates the average severity and returns it as a float value.
+Tombstoned incidents are skipped and do not count towards the average.
 */
 float calculateAverageSeverity(ComplianceManagementSystem system)
 {
@@ -73,8 +230,13 @@ float calculateAverageSeverity(ComplianceManagementSystem system)
 
     // Calculate the total severity of all incidents in the system
     int totalSeverity = 0;
+    int numLive = 0;
     for (int i = 0; i < system.numIncidents; i++)
     {
+        if (isComplianceIncidentTombstoned(&system.incidents[i].dataPrivacyIncident))
+        {
+            continue;
+        }
         ComplianceIncident incident = system.incidents[i].dataPrivacyIncident; // initialize to first incident in union
         switch (system.incidents[i].dataPrivacyIncident.type)
         {
@@ -94,10 +256,17 @@ float calculateAverageSeverity(ComplianceManagementSystem system)
             break; // handle error case
         }
         totalSeverity += incident.severity;
+        numLive++;
+    }
+
+    // Check if every incident in the system is tombstoned
+    if (numLive == 0)
+    {
+        return 0.0;
     }
 
     // Calculate the average severity
-    float averageSeverity = (float)totalSeverity / system.numIncidents;
+    float averageSeverity = (float)totalSeverity / numLive;
 
     return averageSeverity;
 }
@@ -107,7 +276,8 @@ This function removes all incidents of a given type from a Compliance Management
 It loops through all incidents in the system, checks if the incident matches the type to be removed,
 shifts all incidents after this one back by one position, decrements the number of incidents in the system,
 and increments the number of removed incidents. Finally, it zeros out the remaining incidents that were
-shifted back and returns the number of incidents that were removed.
+shifted back and returns the number of incidents that were removed. Tombstoned incidents are already
+removed and are left for compaction.
 */
 int removeComplianceIncidentsOfType(ComplianceManagementSystem *system, ComplianceType type)
 {
@@ -122,8 +292,10 @@ int removeComplianceIncidentsOfType(ComplianceManagementSystem *system, Complian
     {
         ComplianceIncident incident = system->incidents[i].dataPrivacyIncident;
         // Check if the incident matches the type to be removed
-        if (incident.type == type)
+        if (incident.type == type && !isComplianceIncidentTombstoned(&incident))
         {
+            // Let the listeners of the system know about the removal before anything is shifted
+            notifyComplianceMutation(system, INCIDENT_REMOVED, i, incident.severity);
             // Shift all incidents after this one back by one position
             for (int j = i; j < system->numIncidents - 1; j++)
             {
@@ -150,20 +322,26 @@ and returns the incident with the highest severity. If there are no incidents, t
 default empty incident with a data privacy type and a message stating "No incidents in the system."
 The function loops through all incidents in the system and compares their severity with the current highest severity incident,
 updating it if a higher severity incident is found. The function returns the highest severity incident found.
-
+Tombstoned incidents are skipped, so a system holding only tombstoned incidents also returns the empty incident.
 */
 ComplianceIncident findHighestSeverityIncident(ComplianceManagementSystem system)
 {
+    // Skip the tombstoned incidents at the start of the system
+    int first = 0;
+    while (first < system.numIncidents && isComplianceIncidentTombstoned(&system.incidents[first].dataPrivacyIncident))
+    {
+        first++;
+    }
     // Check if there are any incidents in the system
-    if (system.numIncidents == 0)
+    if (first == system.numIncidents)
     {
         ComplianceIncident emptyIncident = {DATA_PRIVACY, "No incidents in the system", 0};
         return emptyIncident;
     }
     // Initialize highest severity incident to the first incident in the system
-    ComplianceIncident highestSeverityIncident = system.incidents[0].dataPrivacyIncident;
+    ComplianceIncident highestSeverityIncident = system.incidents[first].dataPrivacyIncident;
     // Loop through all incidents in the system and find the one with the highest severity
-    for (int i = 0; i < system.numIncidents; i++)
+    for (int i = first; i < system.numIncidents; i++)
     {
         ComplianceIncident currentIncident;
         switch (system.incidents[i].dataPrivacyIncident.type)
@@ -196,7 +374,7 @@ It takes three parameters: a pointer to the compliance management system, the co
 and the new severity value. The function searches for the incident in the system, and if found, checks if the
 new severity value is within the allowed range of 1-10. If the new severity is within the range, it updates
 the incident's severity and returns 0 to indicate success. If the new severity is out of range, it returns 1.
-If the incident is not found in the system, it returns -1.
+If the incident is not found in the system, it returns -1. Tombstoned incidents are never updated.
 */
 int updateComplianceIncidentSeverity(ComplianceManagementSystem *system, ComplianceIncident incident, int newSeverity)
 {
@@ -205,7 +383,8 @@ int updateComplianceIncidentSeverity(ComplianceManagementSystem *system, Complia
     for (i = 0; i < system->numIncidents; i++)
     {
         // check if the incident type and description match
-        if (system->incidents[i].dataPrivacyIncident.type == incident.type &&
+        if (!isComplianceIncidentTombstoned(&system->incidents[i].dataPrivacyIncident) &&
+            system->incidents[i].dataPrivacyIncident.type == incident.type &&
             strcmp(system->incidents[i].dataPrivacyIncident.description, incident.description) == 0)
         {
             found = 1; // set the found flag
@@ -217,7 +396,9 @@ int updateComplianceIncidentSeverity(ComplianceManagementSystem *system, Complia
             else
             {
                 // update the severity of the incident
+                int oldSeverity = system->incidents[i].dataPrivacyIncident.severity;
                 system->incidents[i].dataPrivacyIncident.severity = newSeverity;
+                notifyComplianceMutation(system, INCIDENT_SEVERITY_UPDATED, i, oldSeverity);
                 return 0; // return 0 to indicate the incident was successfully updated
             }
         }
@@ -252,11 +433,194 @@ void removeComplianceIncident(ComplianceManagementSystem *system, ComplianceInci
     {
         return;
     }
+    removeComplianceIncidentAt(system, incidentIndex);
+}
+
+/*
+This function removes the compliance incident at a given position of a management system,
+shifting all incidents after it back by one index and decrementing the number of incidents
+in the system. Removing a tombstoned incident compacts it: the listeners are told with
+INCIDENT_COMPACTED, since the incident was already removed logically. It returns 0 on success
+and -1 if the position is out of range.
+*/
+int removeComplianceIncidentAt(ComplianceManagementSystem *system, int index)
+{
+    if (index < 0 || index >= system->numIncidents)
+    {
+        return -1;
+    }
+    // Let the listeners of the system know about the removal before anything is shifted
+    notifyComplianceRemoval(system, index);
     // Shift all incidents after the removed incident back by one index
-    for (int i = incidentIndex; i < system->numIncidents - 1; i++)
+    for (int i = index; i < system->numIncidents - 1; i++)
     {
         system->incidents[i] = system->incidents[i + 1];
     }
     // Decrement the number of incidents in the system
     system->numIncidents--;
+    return 0;
+}
+
+/*
+This function removes the compliance incidents at a set of positions of a management system in
+one pass. The listeners are told about every removal first, from the highest position down, so
+each index is the one a removal at a time would report and every removed incident is still in
+place. Then each remaining incident after the lowest removed position is moved back once, so
+the cost is one pass over the system however many incidents are removed. Tombstoned incidents
+are compacted as with removeComplianceIncidentAt, and positions past the last incident are
+ignored. It returns the number of incidents removed.
+*/
+int removeComplianceIncidentsAt(ComplianceManagementSystem *system, IncidentBitmap positions)
+{
+    // Let the listeners know about every removal, from the highest position down
+    int numRemoved = 0;
+    int lowest = system->numIncidents;
+    for (int w = INCIDENT_BITMAP_WORDS - 1; w >= 0; w--)
+    {
+        unsigned long long word = positions.words[w];
+        while (word != 0)
+        {
+            int bit = 63 - __builtin_clzll(word);
+            word &= ~(1ULL << bit);
+            if (w * 64 + bit < system->numIncidents)
+            {
+                notifyComplianceRemoval(system, w * 64 + bit);
+                lowest = w * 64 + bit;
+                numRemoved++;
+            }
+        }
+    }
+
+    // Move the remaining incidents back, each one once
+    int kept = lowest;
+    for (int i = lowest; i < system->numIncidents; i++)
+    {
+        if (((positions.words[i / 64] >> (i % 64)) & 1) == 0)
+        {
+            system->incidents[kept++] = system->incidents[i];
+        }
+    }
+    system->numIncidents = kept;
+    return numRemoved;
+}
+
+/*
+This function marks the compliance incident at a given position of a management system as
+removed without moving any incident, so positions held elsewhere stay valid until the incident
+is compacted with removeComplianceIncidentAt. The listeners are told with INCIDENT_TOMBSTONED
+before the severity of the incident is negated. It returns 0 on success and -1 if the position
+is out of range or the incident is already tombstoned.
+*/
+int tombstoneComplianceIncidentAt(ComplianceManagementSystem *system, int index)
+{
+    if (index < 0 || index >= system->numIncidents ||
+        isComplianceIncidentTombstoned(&system->incidents[index].dataPrivacyIncident))
+    {
+        return -1;
+    }
+    int severity = system->incidents[index].dataPrivacyIncident.severity;
+    notifyComplianceMutation(system, INCIDENT_TOMBSTONED, index, severity);
+    system->incidents[index].dataPrivacyIncident.severity = -severity;
+    return 0;
+}
+
+/*
+This function checks whether a compliance incident is tombstoned, that is whether its severity
+is negative. It returns 1 if it is and 0 otherwise.
+*/
+int isComplianceIncidentTombstoned(const ComplianceIncident *incident)
+{
+    return incident->severity < 0;
+}
+
+/*
+This function registers a listener that is called for every incident added to, updated in
+or removed from the given management system. Each system has its own listeners, so any number
+of systems can have listeners at the same time, and the same listener can be registered for
+several systems. It returns 0 on success and -1 if the system already has
+MAX_MUTATION_LISTENERS listeners or the memory could not be allocated.
+*/
+int addComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context)
+{
+    pthread_rwlock_wrlock(&mutationListenerLock);
+    if (2 * (numMutationListenerSets + 1) > numMutationListenerSlots && growMutationListenerSets() != 0)
+    {
+        pthread_rwlock_unlock(&mutationListenerLock);
+        return -1;
+    }
+    MutationListenerSet *set = &mutationListenerSets[findMutationListenerSlot(system)];
+    if (set->system == NULL)
+    {
+        set->system = system;
+        set->numEntries = 0;
+        numMutationListenerSets++;
+    }
+    if (set->numEntries == MAX_MUTATION_LISTENERS)
+    {
+        pthread_rwlock_unlock(&mutationListenerLock);
+        return -1;
+    }
+    set->entries[set->numEntries].listener = listener;
+    set->entries[set->numEntries].context = context;
+    set->numEntries++;
+    __atomic_add_fetch(&numMutationListeners, 1, __ATOMIC_RELEASE);
+    pthread_rwlock_unlock(&mutationListenerLock);
+    return 0;
+}
+
+/*
+This function unregisters a listener that was registered for the given management system
+with the same context. Listeners registered after it keep their relative order. If the
+listener is not registered, the function returns without changing anything.
+*/
+void removeComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context)
+{
+    pthread_rwlock_wrlock(&mutationListenerLock);
+    if (numMutationListenerSlots == 0)
+    {
+        pthread_rwlock_unlock(&mutationListenerLock);
+        return;
+    }
+    int slot = findMutationListenerSlot(system);
+    MutationListenerSet *set = &mutationListenerSets[slot];
+    for (int i = 0; set->system == system && i < set->numEntries; i++)
+    {
+        if (set->entries[i].listener == listener && set->entries[i].context == context)
+        {
+            for (int j = i; j < set->numEntries - 1; j++)
+            {
+                set->entries[j] = set->entries[j + 1];
+            }
+            set->numEntries--;
+            __atomic_sub_fetch(&numMutationListeners, 1, __ATOMIC_RELEASE);
+            if (set->numEntries == 0)
+            {
+                releaseMutationListenerSlot(slot);
+            }
+            break;
+        }
+    }
+    pthread_rwlock_unlock(&mutationListenerLock);
+}
+
+/*
+This function hashes the description of a compliance incident with 64-bit FNV-1a, followed by
+a final mixing step so that descriptions differing only in their last characters still differ
+in the high bits. The hash is used wherever descriptions need to be identified compactly without
+keeping the text.
+*/
+unsigned long long hashIncidentDescription(const char *description)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (int i = 0; i < 100 && description[i] != '\0'; i++)
+    {
+        hash ^= (unsigned char)description[i];
+        hash *= 1099511628211ULL;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
 }
@@ -0,0 +1,239 @@
+#include "bitmapindex.h"
+
+/*
+This helper is the mutation listener of the bitmap indexes. An add sets the bits of the new
+position, a severity update moves the position between severity bitmaps, a tombstone clears the
+bits of the position, and a removal or compaction drops the position from every bitmap.
+*/
+static void recordIndexMutation(void *context, const ComplianceMutation *mutation)
+{
+    IncidentBitmapIndex *index = (IncidentBitmapIndex *)context;
+    switch (mutation->kind)
+    {
+    case INCIDENT_ADDED:
+        bitmapSetPosition(&index->typeBitmaps[mutation->incident->type], mutation->index);
+        bitmapSetPosition(&index->severityBitmaps[mutation->incident->severity], mutation->index);
+        break;
+    case INCIDENT_SEVERITY_UPDATED:
+        bitmapClearPosition(&index->severityBitmaps[mutation->oldSeverity], mutation->index);
+        bitmapSetPosition(&index->severityBitmaps[mutation->incident->severity], mutation->index);
+        break;
+    case INCIDENT_TOMBSTONED:
+        bitmapClearPosition(&index->typeBitmaps[mutation->incident->type], mutation->index);
+        bitmapClearPosition(&index->severityBitmaps[mutation->oldSeverity], mutation->index);
+        break;
+    case INCIDENT_REMOVED:
+    case INCIDENT_COMPACTED:
+        for (int type = 0; type < 4; type++)
+        {
+            bitmapRemovePosition(&index->typeBitmaps[type], mutation->index);
+        }
+        for (int severity = 1; severity <= 10; severity++)
+        {
+            bitmapRemovePosition(&index->severityBitmaps[severity], mutation->index);
+        }
+        break;
+    }
+}
+
+/*
+This function builds the type and severity bitmaps of a management system with one scan over
+its incidents, then registers them as a mutation listener so every add, severity update and
+removal keeps them up to date. Incidents with an invalid type or severity are left out. It
+returns 0 on success and -1 if no more listeners can be registered.
+*/
+int attachBitmapIndex(IncidentBitmapIndex *index, ComplianceManagementSystem *system)
+{
+    memset(index, 0, sizeof(IncidentBitmapIndex));
+    index->system = system;
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        if ((unsigned int)incident->type < 4 && incident->severity >= 1 && incident->severity <= 10)
+        {
+            bitmapSetPosition(&index->typeBitmaps[incident->type], i);
+            bitmapSetPosition(&index->severityBitmaps[incident->severity], i);
+        }
+    }
+    return addComplianceMutationListener(system, recordIndexMutation, index);
+}
+
+/*
+This function stops keeping the bitmap indexes of a management system up to date.
+*/
+void detachBitmapIndex(IncidentBitmapIndex *index)
+{
+    removeComplianceMutationListener(index->system, recordIndexMutation, index);
+}
+
+/*
+This function returns the positions of the incidents of a certain type.
+*/
+IncidentBitmap indexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type)
+{
+    return index->typeBitmaps[type];
+}
+
+/*
+This function returns the positions of the incidents with a severity between minSeverity and
+maxSeverity, both included, by uniting the bitmaps of those severities.
+*/
+IncidentBitmap indexedIncidentsWithSeverity(const IncidentBitmapIndex *index, int minSeverity, int maxSeverity)
+{
+    IncidentBitmap bitmap;
+    memset(&bitmap, 0, sizeof(IncidentBitmap));
+    for (int severity = minSeverity < 1 ? 1 : minSeverity; severity <= maxSeverity && severity <= 10; severity++)
+    {
+        bitmap = bitmapOr(bitmap, index->severityBitmaps[severity]);
+    }
+    return bitmap;
+}
+
+/*
+This function returns the positions that are in both bitmaps.
+*/
+IncidentBitmap bitmapAnd(IncidentBitmap a, IncidentBitmap b)
+{
+    for (int w = 0; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        a.words[w] &= b.words[w];
+    }
+    return a;
+}
+
+/*
+This function returns the positions that are in either bitmap.
+*/
+IncidentBitmap bitmapOr(IncidentBitmap a, IncidentBitmap b)
+{
+    for (int w = 0; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        a.words[w] |= b.words[w];
+    }
+    return a;
+}
+
+/*
+This function returns the positions of the first bitmap that are not in the second one.
+*/
+IncidentBitmap bitmapAndNot(IncidentBitmap a, IncidentBitmap b)
+{
+    for (int w = 0; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        a.words[w] &= ~b.words[w];
+    }
+    return a;
+}
+
+/*
+This function adds one incident position to a bitmap.
+*/
+void bitmapSetPosition(IncidentBitmap *bitmap, int position)
+{
+    bitmap->words[position / 64] |= 1ULL << (position % 64);
+}
+
+/*
+This function takes one incident position out of a bitmap, leaving the other positions as they are.
+*/
+void bitmapClearPosition(IncidentBitmap *bitmap, int position)
+{
+    bitmap->words[position / 64] &= ~(1ULL << (position % 64));
+}
+
+/*
+This function drops one position from a bitmap and moves every higher position down by one,
+mirroring how the removal functions shift the incidents after a removed one back by one index.
+*/
+void bitmapRemovePosition(IncidentBitmap *bitmap, int position)
+{
+    for (int w = 0; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        int base = w * 64;
+        if (position >= base + 64)
+        {
+            continue;
+        }
+        unsigned long long word = bitmap->words[w];
+        unsigned long long carry = w + 1 < INCIDENT_BITMAP_WORDS ? (bitmap->words[w + 1] & 1) << 63 : 0;
+        if (position <= base)
+        {
+            word >>= 1;
+        }
+        else
+        {
+            unsigned long long lowMask = (1ULL << (position - base)) - 1;
+            word = (word & lowMask) | ((word >> 1) & ~lowMask);
+        }
+        bitmap->words[w] = word | carry;
+    }
+}
+
+/*
+This function counts the positions in a bitmap.
+*/
+int bitmapCardinality(IncidentBitmap bitmap)
+{
+    int count = 0;
+    for (int w = 0; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        count += __builtin_popcountll(bitmap.words[w]);
+    }
+    return count;
+}
+
+/*
+This function finds the first position in a bitmap at or after a given one, so the positions
+can be walked with for (p = bitmapNextPosition(b, 0); p != -1; p = bitmapNextPosition(b, p + 1)).
+It returns -1 if there is no such position.
+*/
+int bitmapNextPosition(IncidentBitmap bitmap, int from)
+{
+    if (from < 0)
+    {
+        from = 0;
+    }
+    for (int w = from / 64; w < INCIDENT_BITMAP_WORDS; w++)
+    {
+        unsigned long long word = bitmap.words[w];
+        if (w == from / 64)
+        {
+            word &= ~0ULL << (from % 64);
+        }
+        if (word != 0)
+        {
+            return w * 64 + __builtin_ctzll(word);
+        }
+    }
+    return -1;
+}
+
+/*
+This function counts the incidents of a certain type by reading the cardinality of its bitmap,
+without looking at the incidents.
+*/
+int countIndexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type)
+{
+    return bitmapCardinality(index->typeBitmaps[type]);
+}
+
+/*
+This function removes the incidents at the positions of a bitmap from the indexed management
+system, for example a combination of type and severity bitmaps, with removeComplianceIncidentsAt.
+The system is compacted in one pass, and the indexes follow along through the mutation listener
+at a fixed cost per removed incident. It returns the number of incidents removed.
+*/
+int removeIndexedIncidents(IncidentBitmapIndex *index, IncidentBitmap bitmap)
+{
+    return removeComplianceIncidentsAt(index->system, bitmap);
+}
+
+/*
+This function removes all incidents of a certain type from the indexed management system. Only
+the positions in the type bitmap are visited, so finding the incidents costs time proportional
+to the number removed rather than to the size of the system.
+*/
+int removeIndexedIncidentsOfType(IncidentBitmapIndex *index, ComplianceType type)
+{
+    return removeIndexedIncidents(index, index->typeBitmaps[type]);
+}
@@ -0,0 +1,119 @@
+#include "changefeed.h"
+
+/*
+This helper is the mutation listener of a change feed. It packs the mutation into a
+compact delta record, writes it into the next slot of the ring buffer and then publishes
+the record by advancing the feed sequence. Once the ring buffer is full the oldest record
+is overwritten, so the writer never waits for readers.
+*/
+static void recordChangeFeedMutation(void *context, const ComplianceMutation *mutation)
+{
+    ChangeFeed *feed = (ChangeFeed *)context;
+    unsigned long sequence = feed->nextSequence;
+    ComplianceDelta *record = &feed->records[sequence & (CHANGE_FEED_CAPACITY - 1)];
+    record->sequence = (unsigned int)sequence;
+    record->descriptionHash = (unsigned int)hashIncidentDescription(mutation->incident->description);
+    record->index = (short)mutation->index;
+    record->kind = (unsigned char)mutation->kind;
+    record->type = (unsigned char)mutation->incident->type;
+    record->oldSeverity = (unsigned char)mutation->oldSeverity;
+    record->newSeverity = (unsigned char)(mutation->kind == INCIDENT_ADDED || mutation->kind == INCIDENT_SEVERITY_UPDATED ? mutation->incident->severity : 0);
+    __atomic_store_n(&feed->nextSequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+/*
+This function attaches an empty change feed to a management system by registering it as
+a mutation listener. From then on every add, severity update and removal applied to the
+system is appended to the feed. It returns 0 on success and -1 if no more listeners can be
+registered.
+*/
+int attachChangeFeed(ChangeFeed *feed, ComplianceManagementSystem *system)
+{
+    feed->nextSequence = 0;
+    feed->system = system;
+    return addComplianceMutationListener(system, recordChangeFeedMutation, feed);
+}
+
+/*
+This function stops recording mutations into a change feed. Records already in the feed
+can still be read.
+*/
+void detachChangeFeed(ChangeFeed *feed)
+{
+    removeComplianceMutationListener(feed->system, recordChangeFeedMutation, feed);
+}
+
+/*
+This helper checks whether a reader at a sequence has lagged behind the writer. The slot the
+writer fills next still holds the record from CHANGE_FEED_CAPACITY sequences earlier, but it
+may be overwritten at any moment, so that record already counts as lost.
+*/
+static int isChangeFeedReaderLagging(unsigned long readerSequence, unsigned long nextSequence)
+{
+    return readerSequence + CHANGE_FEED_CAPACITY <= nextSequence;
+}
+
+/*
+This function returns the oldest sequence that can still be read from a change feed. Cursors
+positioned before it have lagged behind the writer and lost records. The slot the writer fills
+next is not counted, so at most CHANGE_FEED_CAPACITY - 1 records can be read back.
+*/
+unsigned long oldestChangeFeedSequence(const ChangeFeed *feed)
+{
+    unsigned long nextSequence = __atomic_load_n(&feed->nextSequence, __ATOMIC_ACQUIRE);
+    if (nextSequence < CHANGE_FEED_CAPACITY)
+    {
+        return 0;
+    }
+    return nextSequence - CHANGE_FEED_CAPACITY + 1;
+}
+
+/*
+This function positions a cursor at a sequence of a change feed. A reader resumes from the
+sequence it last saw plus one, or starts from oldestChangeFeedSequence to replay everything
+still held.
+*/
+void seekChangeFeedCursor(ChangeFeedCursor *cursor, unsigned long sequence)
+{
+    cursor->sequence = sequence;
+}
+
+/*
+This function copies up to maxRecords delta records starting at the cursor and advances
+the cursor past them. It returns the number of records copied, which is 0 when the reader
+has caught up with the writer. If the cursor points at records that have already been
+overwritten, either before or during the copy, the function returns -1 and leaves the
+cursor unchanged so the reader can resynchronize.
+*/
+int readChangeFeed(const ChangeFeed *feed, ChangeFeedCursor *cursor, ComplianceDelta *records, int maxRecords)
+{
+    unsigned long nextSequence = __atomic_load_n(&feed->nextSequence, __ATOMIC_ACQUIRE);
+    // Check if the reader has lagged behind the writer
+    if (isChangeFeedReaderLagging(cursor->sequence, nextSequence))
+    {
+        return -1;
+    }
+    // Check if there is nothing new to read
+    if (cursor->sequence >= nextSequence)
+    {
+        return 0;
+    }
+
+    int numRecords = 0;
+    for (unsigned long sequence = cursor->sequence; sequence < nextSequence && numRecords < maxRecords; sequence++)
+    {
+        records[numRecords] = feed->records[sequence & (CHANGE_FEED_CAPACITY - 1)];
+        numRecords++;
+    }
+
+    // Check if the writer wrapped around onto the copied records while they were read,
+    // including the record in the slot it may be writing right now
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    unsigned long latestSequence = __atomic_load_n(&feed->nextSequence, __ATOMIC_ACQUIRE);
+    if (isChangeFeedReaderLagging(cursor->sequence, latestSequence))
+    {
+        return -1;
+    }
+    cursor->sequence += numRecords;
+    return numRecords;
+}
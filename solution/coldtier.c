@@ -0,0 +1,468 @@
+#include "coldtier.h"
+
+/*
+Compressed descriptions are a stream of tokens. A token byte below 0x80 is followed by
+that many plus one literal bytes. A token byte of 0x80 or above copies (byte & 0x7F) + 3
+bytes from the window, starting the number of bytes back given by the two bytes that
+follow it. The window is the shared dictionary followed by the text already decoded in
+the same block, and every description is stored with its terminating zero byte so the
+decoder knows where it ends.
+*/
+#define COLD_MIN_MATCH 3
+#define COLD_MAX_MATCH (0x7F + COLD_MIN_MATCH)
+#define COLD_MAX_LITERALS 0x80
+#define COLD_HASH_SIZE 4096
+#define COLD_MAX_CHAIN 64
+
+/*
+This helper makes sure a growable buffer can hold at least the requested number of
+elements, doubling its capacity as needed. It returns 0 on success and -1 if the memory
+could not be allocated, in which case the buffer is left untouched.
+*/
+static int reserveColdBuffer(void **buffer, int *capacity, int required, int elementSize)
+{
+    if (required <= *capacity)
+    {
+        return 0;
+    }
+    int newCapacity = *capacity > 0 ? *capacity : 64;
+    while (newCapacity < required)
+    {
+        newCapacity *= 2;
+    }
+    void *newBuffer = realloc(*buffer, (size_t)newCapacity * elementSize);
+    if (newBuffer == NULL)
+    {
+        return -1;
+    }
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+    return 0;
+}
+
+/*
+This helper hashes the three bytes starting at a window position into a hash chain slot.
+*/
+static int hashColdPosition(const char *window, int position)
+{
+    unsigned int key = ((unsigned char)window[position] << 16) | ((unsigned char)window[position + 1] << 8) |
+                       (unsigned char)window[position + 2];
+    return (int)((key * 2654435761u) >> 20) & (COLD_HASH_SIZE - 1);
+}
+
+/*
+This helper links a window position into its hash chain. Positions with fewer than three
+bytes after them are skipped since they cannot start a match.
+*/
+static void insertColdPosition(ColdTier *tier, int position)
+{
+    if (position + 2 >= tier->windowLength)
+    {
+        return;
+    }
+    int slot = hashColdPosition(tier->window, position);
+    tier->hashPrevious[position] = tier->hashHead[slot];
+    tier->hashHead[slot] = position;
+}
+
+/*
+This helper empties the window back to just the dictionary when a new block starts, and
+rebuilds the hash chains over the dictionary.
+*/
+static void resetColdWindow(ColdTier *tier)
+{
+    tier->windowLength = tier->dictionarySize;
+    for (int i = 0; i < COLD_HASH_SIZE; i++)
+    {
+        tier->hashHead[i] = -1;
+    }
+    for (int position = 0; position < tier->dictionarySize; position++)
+    {
+        insertColdPosition(tier, position);
+    }
+}
+
+/*
+This helper appends a run of literal bytes to the compressed data, splitting it into
+tokens of at most COLD_MAX_LITERALS bytes.
+*/
+static void emitColdLiterals(ColdTier *tier, const char *literals, int length)
+{
+    while (length > 0)
+    {
+        int run = length < COLD_MAX_LITERALS ? length : COLD_MAX_LITERALS;
+        tier->data[tier->dataSize++] = (unsigned char)(run - 1);
+        memcpy(&tier->data[tier->dataSize], literals, run);
+        tier->dataSize += run;
+        literals += run;
+        length -= run;
+    }
+}
+
+/*
+This helper compresses one description into the compressed data. The description is first
+appended to the window, then encoded greedily: at each position the hash chain of its first
+three bytes is followed to find the longest earlier match in the window, and positions without
+a match of at least COLD_MIN_MATCH bytes are kept as literals.
+*/
+static void compressColdDescription(ColdTier *tier, const char *description)
+{
+    int length = (int)strlen(description) + 1;
+    int start = tier->windowLength;
+    memcpy(&tier->window[start], description, length);
+    tier->windowLength += length;
+
+    int literalStart = start;
+    int current = start;
+    while (current < tier->windowLength)
+    {
+        // Find the longest match for the remaining bytes of the description
+        int bestLength = 0;
+        int bestDistance = 0;
+        int maxLength = tier->windowLength - current < COLD_MAX_MATCH ? tier->windowLength - current : COLD_MAX_MATCH;
+        if (maxLength >= COLD_MIN_MATCH)
+        {
+            int candidate = tier->hashHead[hashColdPosition(tier->window, current)];
+            for (int chain = 0; candidate >= 0 && chain < COLD_MAX_CHAIN; chain++)
+            {
+                int matchLength = 0;
+                while (matchLength < maxLength && tier->window[candidate + matchLength] == tier->window[current + matchLength])
+                {
+                    matchLength++;
+                }
+                if (matchLength > bestLength)
+                {
+                    bestLength = matchLength;
+                    bestDistance = current - candidate;
+                }
+                candidate = tier->hashPrevious[candidate];
+            }
+        }
+
+        if (bestLength < COLD_MIN_MATCH)
+        {
+            insertColdPosition(tier, current);
+            current++;
+            continue;
+        }
+        emitColdLiterals(tier, &tier->window[literalStart], current - literalStart);
+        tier->data[tier->dataSize++] = (unsigned char)(0x80 | (bestLength - COLD_MIN_MATCH));
+        tier->data[tier->dataSize++] = (unsigned char)(bestDistance >> 8);
+        tier->data[tier->dataSize++] = (unsigned char)(bestDistance & 0xFF);
+        for (int i = 0; i < bestLength; i++)
+        {
+            insertColdPosition(tier, current + i);
+        }
+        current += bestLength;
+        literalStart = current;
+    }
+    emitColdLiterals(tier, &tier->window[literalStart], current - literalStart);
+}
+
+/*
+This helper decompresses one description starting at the given offset of the compressed
+data. The text is appended to the scratch window and the offset just past its tokens is
+returned.
+*/
+static int decompressColdDescription(ColdTier *tier, int offset, int *windowLength)
+{
+    char *window = tier->scratch;
+    for (;;)
+    {
+        unsigned char token = tier->data[offset++];
+        if (token < 0x80)
+        {
+            int run = token + 1;
+            memcpy(&window[*windowLength], &tier->data[offset], run);
+            offset += run;
+            *windowLength += run;
+        }
+        else
+        {
+            int matchLength = (token & 0x7F) + COLD_MIN_MATCH;
+            int distance = (tier->data[offset] << 8) | tier->data[offset + 1];
+            offset += 2;
+            // Copy byte by byte since the match may overlap the bytes it produces
+            for (int i = 0; i < matchLength; i++)
+            {
+                window[*windowLength] = window[*windowLength - distance];
+                (*windowLength)++;
+            }
+        }
+        if (window[*windowLength - 1] == '\0')
+        {
+            return offset;
+        }
+    }
+}
+
+/*
+This function initializes an empty cold tier. The number of incidents per block sets the
+trade-off between memory and lookup latency: descriptions can only reference text earlier in
+their own block, so larger blocks find more matches but a lookup has to decode the block from
+its start. The value is clamped to between 1 and COLD_MAX_INCIDENTS_PER_BLOCK. The function
+returns 0 on success and -1 if memory could not be allocated.
+*/
+int initColdTier(ColdTier *tier, int incidentsPerBlock)
+{
+    memset(tier, 0, sizeof(ColdTier));
+    if (incidentsPerBlock < 1)
+    {
+        incidentsPerBlock = 1;
+    }
+    if (incidentsPerBlock > COLD_MAX_INCIDENTS_PER_BLOCK)
+    {
+        incidentsPerBlock = COLD_MAX_INCIDENTS_PER_BLOCK;
+    }
+    tier->incidentsPerBlock = incidentsPerBlock;
+    size_t windowSize = COLD_DICTIONARY_SIZE + (size_t)incidentsPerBlock * 100;
+    tier->window = (char *)malloc(windowSize);
+    tier->scratch = (char *)malloc(windowSize);
+    tier->hashHead = (int *)malloc(COLD_HASH_SIZE * sizeof(int));
+    tier->hashPrevious = (int *)malloc(windowSize * sizeof(int));
+    if (tier->window == NULL || tier->scratch == NULL || tier->hashHead == NULL || tier->hashPrevious == NULL)
+    {
+        destroyColdTier(tier);
+        return -1;
+    }
+    resetColdWindow(tier);
+    return 0;
+}
+
+/*
+This function releases the memory owned by a cold tier and leaves it empty.
+*/
+void destroyColdTier(ColdTier *tier)
+{
+    free(tier->types);
+    free(tier->severities);
+    free(tier->data);
+    free(tier->blockOffsets);
+    free(tier->window);
+    free(tier->scratch);
+    free(tier->hashHead);
+    free(tier->hashPrevious);
+    memset(tier, 0, sizeof(ColdTier));
+}
+
+/*
+This function trains the shared dictionary of a cold tier from the descriptions of a set of
+sample incidents. It counts how often each word occurs and fills the dictionary with the words
+that save the most bytes, placing the most valuable words last so they sit closest to the text
+being compressed. Tombstoned samples are skipped. The dictionary can only be trained while the
+cold tier is empty; the function returns 0 on success and -1 otherwise.
+*/
+int trainColdDictionary(ColdTier *tier, const ComplianceManagementSystem *samples)
+{
+    if (tier->numIncidents > 0)
+    {
+        return -1;
+    }
+
+    // Count the words of the sample descriptions
+    char words[256][100];
+    int counts[256];
+    int numWords = 0;
+    for (int i = 0; i < samples->numIncidents; i++)
+    {
+        if (isComplianceIncidentTombstoned(&samples->incidents[i].dataPrivacyIncident))
+        {
+            continue;
+        }
+        const char *description = samples->incidents[i].dataPrivacyIncident.description;
+        int length = (int)strlen(description);
+        int wordStart = 0;
+        for (int j = 0; j <= length; j++)
+        {
+            if (j < length && description[j] != ' ')
+            {
+                continue;
+            }
+            int wordLength = j - wordStart;
+            if (wordLength >= COLD_MIN_MATCH)
+            {
+                int w = 0;
+                while (w < numWords && !(strncmp(words[w], &description[wordStart], wordLength) == 0 && words[w][wordLength] == '\0'))
+                {
+                    w++;
+                }
+                if (w == numWords && numWords < 256)
+                {
+                    memcpy(words[w], &description[wordStart], wordLength);
+                    words[w][wordLength] = '\0';
+                    counts[w] = 0;
+                    numWords++;
+                }
+                if (w < numWords)
+                {
+                    counts[w]++;
+                }
+            }
+            wordStart = j + 1;
+        }
+    }
+
+    // Sort the words by the number of bytes they would save, least valuable first
+    for (int i = 1; i < numWords; i++)
+    {
+        for (int j = i; j > 0 && counts[j - 1] * (int)strlen(words[j - 1]) > counts[j] * (int)strlen(words[j]); j--)
+        {
+            char word[100];
+            int count = counts[j];
+            strcpy(word, words[j]);
+            strcpy(words[j], words[j - 1]);
+            counts[j] = counts[j - 1];
+            strcpy(words[j - 1], word);
+            counts[j - 1] = count;
+        }
+    }
+
+    // Keep the most valuable words that fit, followed by a space each
+    int first = numWords;
+    int size = 0;
+    while (first > 0 && size + (int)strlen(words[first - 1]) + 1 <= COLD_DICTIONARY_SIZE)
+    {
+        first--;
+        size += (int)strlen(words[first]) + 1;
+    }
+    tier->dictionarySize = 0;
+    for (int i = first; i < numWords; i++)
+    {
+        int wordLength = (int)strlen(words[i]);
+        memcpy(&tier->window[tier->dictionarySize], words[i], wordLength);
+        tier->window[tier->dictionarySize + wordLength] = ' ';
+        tier->dictionarySize += wordLength + 1;
+    }
+    memcpy(tier->scratch, tier->window, tier->dictionarySize);
+    resetColdWindow(tier);
+    return 0;
+}
+
+/*
+This function moves up to count of the oldest incidents of a management system into a cold
+tier. The type and severity of each incident are appended to the uncompressed columns and its
+description is compressed into the current block. Tombstoned incidents met on the way are not
+moved but are compacted along with the others: once the frozen prefix is known, it is removed
+from the system in one pass with removeComplianceIncidentsAt. It returns the number of incidents
+moved, which is smaller than count if the system runs out of incidents or memory could not be
+allocated.
+*/
+int freezeOldestIncidents(ColdTier *tier, ComplianceManagementSystem *system, int count)
+{
+    int numMoved = 0;
+    int position = 0;
+    IncidentBitmap frozen;
+    memset(&frozen, 0, sizeof(IncidentBitmap));
+    for (; numMoved < count && position < system->numIncidents; position++)
+    {
+        ComplianceIncident incident = system->incidents[position].dataPrivacyIncident;
+        if (isComplianceIncidentTombstoned(&incident))
+        {
+            frozen.words[position / 64] |= 1ULL << (position % 64);
+            continue;
+        }
+
+        // Make room for the incident in the columns and the compressed data
+        int typeCapacity = tier->capacity;
+        int severityCapacity = tier->capacity;
+        if (reserveColdBuffer((void **)&tier->types, &typeCapacity, tier->numIncidents + 1, 1) != 0 ||
+            reserveColdBuffer((void **)&tier->severities, &severityCapacity, tier->numIncidents + 1, 1) != 0)
+        {
+            break;
+        }
+        tier->capacity = typeCapacity < severityCapacity ? typeCapacity : severityCapacity;
+        if (reserveColdBuffer((void **)&tier->data, &tier->dataCapacity, tier->dataSize + 128, 1) != 0 ||
+            reserveColdBuffer((void **)&tier->blockOffsets, &tier->blockCapacity, tier->numBlocks + 1, sizeof(int)) != 0)
+        {
+            break;
+        }
+
+        // Start a new block when the current one is full
+        if (tier->numIncidents % tier->incidentsPerBlock == 0)
+        {
+            tier->blockOffsets[tier->numBlocks++] = tier->dataSize;
+            resetColdWindow(tier);
+        }
+        tier->types[tier->numIncidents] = (unsigned char)incident.type;
+        tier->severities[tier->numIncidents] = (unsigned char)incident.severity;
+        compressColdDescription(tier, incident.description);
+        tier->numIncidents++;
+        frozen.words[position / 64] |= 1ULL << (position % 64);
+        numMoved++;
+    }
+    removeComplianceIncidentsAt(system, frozen);
+    return numMoved;
+}
+
+/*
+This function looks up an incident of a cold tier by its position, oldest first. The type
+and severity are read from the uncompressed columns, and the description is decompressed by
+decoding the block of the incident up to and including it. The compressed bytes decoded are
+added to decodedBytes, which shows the lookup latency side of the trade-off. It returns 0 on
+success and -1 if the index is out of range.
+*/
+int getColdIncident(ColdTier *tier, int index, ComplianceIncident *incident)
+{
+    if (index < 0 || index >= tier->numIncidents)
+    {
+        return -1;
+    }
+    int block = index / tier->incidentsPerBlock;
+    int offset = tier->blockOffsets[block];
+    int windowLength = tier->dictionarySize;
+    int descriptionStart = windowLength;
+    for (int i = block * tier->incidentsPerBlock; i <= index; i++)
+    {
+        descriptionStart = windowLength;
+        offset = decompressColdDescription(tier, offset, &windowLength);
+    }
+    tier->decodedBytes += offset - tier->blockOffsets[block];
+    incident->type = (ComplianceType)tier->types[index];
+    incident->severity = tier->severities[index];
+    memcpy(incident->description, &tier->scratch[descriptionStart], windowLength - descriptionStart);
+    return 0;
+}
+
+/*
+This function calculates the average severity of the incidents in a cold tier. Only the
+severity column is read, so no description is decompressed. It returns 0 if the cold tier
+is empty.
+*/
+float calculateColdAverageSeverity(const ColdTier *tier)
+{
+    if (tier->numIncidents == 0)
+    {
+        return 0.0;
+    }
+    int totalSeverity = 0;
+    for (int i = 0; i < tier->numIncidents; i++)
+    {
+        totalSeverity += tier->severities[i];
+    }
+    return (float)totalSeverity / tier->numIncidents;
+}
+
+/*
+This function counts the incidents of a certain type in a cold tier by reading only the
+type column.
+*/
+int countColdIncidentsOfType(const ColdTier *tier, ComplianceType type)
+{
+    int count = 0;
+    for (int i = 0; i < tier->numIncidents; i++)
+    {
+        count += tier->types[i] == type;
+    }
+    return count;
+}
+
+/*
+This function reports the number of bytes used to store the incidents of a cold tier: the
+two uncompressed columns, the compressed descriptions, the block offsets and the dictionary.
+Comparing it with numIncidents * sizeof(ComplianceIncident) for different block sizes shows
+the memory side of the trade-off, and decodedBytes the lookup latency side.
+*/
+int coldTierMemoryUsage(const ColdTier *tier)
+{
+    return tier->numIncidents * 2 + tier->dataSize + tier->numBlocks * (int)sizeof(int) + tier->dictionarySize;
+}
@@ -0,0 +1,253 @@
+#include "escalation.h"
+
+/*
+This helper returns the bucket of a rule. Count rules are grouped by type and minimum severity,
+average rules by type, so all rules of a bucket compare their threshold against the same value.
+*/
+static int escalationRuleBucket(const EscalationRule *rule)
+{
+    if (rule->kind == SEVERITY_COUNT_ABOVE)
+    {
+        return rule->type * 10 + rule->minSeverity - 1;
+    }
+    return 40 + rule->type;
+}
+
+/*
+This helper returns the value the rules of a bucket compare against: a number of incidents for
+count buckets and an average severity for average buckets.
+*/
+static float escalationBucketValue(const EscalationEngine *engine, int bucket)
+{
+    if (bucket < 40)
+    {
+        return (float)engine->severityAtLeast[bucket / 10][bucket % 10 + 1];
+    }
+    int type = bucket - 40;
+    if (engine->numIncidents[type] == 0)
+    {
+        return 0.0;
+    }
+    return (float)engine->totalSeverity[type] / engine->numIncidents[type];
+}
+
+/*
+This helper delivers an event to the callback of the engine, or queues it when there is no
+callback. An event that finds the queue full is dropped and counted.
+*/
+static void raiseEscalationEvent(EscalationEngine *engine, int ruleId, unsigned long sequence, float value)
+{
+    EscalationEvent event;
+    event.ruleId = ruleId;
+    event.type = engine->rules[ruleId].type;
+    event.sequence = sequence;
+    event.value = value;
+    if (engine->callback != NULL)
+    {
+        engine->callback(engine->callbackContext, &event);
+    }
+    else if (engine->eventTail - engine->eventHead < ESCALATION_EVENT_CAPACITY)
+    {
+        engine->events[engine->eventTail % ESCALATION_EVENT_CAPACITY] = event;
+        engine->eventTail++;
+    }
+    else
+    {
+        engine->numDroppedEvents++;
+    }
+}
+
+/*
+This helper brings the rules of one bucket up to date with the current value of the bucket. The
+rules are sorted by threshold, so the rules that hold always form a prefix of the bucket, and
+only the rules between the old and the new end of that prefix are visited. Rules that start to
+hold raise an event; rules that stop holding are rearmed silently.
+*/
+static void refreshEscalationBucket(EscalationEngine *engine, int bucket, unsigned long sequence)
+{
+    int start = engine->bucketStart[bucket];
+    int end = engine->bucketStart[bucket + 1];
+    if (start == end)
+    {
+        return;
+    }
+    float value = escalationBucketValue(engine, bucket);
+    int holding = engine->bucketHolding[bucket];
+    while (start + holding < end && engine->rules[engine->ruleOrder[start + holding]].threshold < value)
+    {
+        raiseEscalationEvent(engine, engine->ruleOrder[start + holding], sequence, value);
+        holding++;
+    }
+    while (holding > 0 && engine->rules[engine->ruleOrder[start + holding - 1]].threshold >= value)
+    {
+        holding--;
+    }
+    engine->bucketHolding[bucket] = holding;
+}
+
+/*
+This helper adds one incident to, or with a negative sign removes it from, the per-type counts
+of the engine. Incidents with an invalid type or severity are left out.
+*/
+static int countEscalationIncident(EscalationEngine *engine, ComplianceType type, int severity, int sign)
+{
+    if ((unsigned int)type >= 4 || severity < 1 || severity > 10)
+    {
+        return 0;
+    }
+    for (int s = 1; s <= severity; s++)
+    {
+        engine->severityAtLeast[type][s] += sign;
+    }
+    engine->numIncidents[type] += sign;
+    engine->totalSeverity[type] += sign * severity;
+    return 1;
+}
+
+/*
+This helper is the mutation listener of an escalation engine. It updates the counts of the type
+of the mutated incident, then refreshes only the eleven buckets of that type, so the work per
+mutation does not depend on how many rules are installed beyond the rules whose state changes.
+*/
+static void evaluateEscalationMutation(void *context, const ComplianceMutation *mutation)
+{
+    EscalationEngine *engine = (EscalationEngine *)context;
+    ComplianceType type = mutation->incident->type;
+    int counted = 0;
+    switch (mutation->kind)
+    {
+    case INCIDENT_ADDED:
+        counted = countEscalationIncident(engine, type, mutation->incident->severity, 1);
+        break;
+    case INCIDENT_SEVERITY_UPDATED:
+        counted = countEscalationIncident(engine, type, mutation->oldSeverity, -1);
+        counted |= countEscalationIncident(engine, type, mutation->incident->severity, 1);
+        break;
+    case INCIDENT_REMOVED:
+    case INCIDENT_TOMBSTONED:
+        counted = countEscalationIncident(engine, type, mutation->oldSeverity, -1);
+        break;
+    case INCIDENT_COMPACTED:
+        break;
+    }
+    if (!counted)
+    {
+        return;
+    }
+    for (int bucket = (int)type * 10; bucket < (int)type * 10 + 10; bucket++)
+    {
+        refreshEscalationBucket(engine, bucket, mutation->sequence);
+    }
+    refreshEscalationBucket(engine, 40 + (int)type, mutation->sequence);
+}
+
+/*
+This function attaches an escalation engine without rules to a management system. The per-type
+counts start from one scan of the incidents already in the system and are then kept up to date
+by a mutation listener, which evaluates the rules inside every add, severity update and removal.
+Events go to the callback if one is given, and to the event queue otherwise. It returns 0 on
+success and -1 if no more listeners can be registered.
+*/
+int attachEscalationEngine(EscalationEngine *engine, ComplianceManagementSystem *system, EscalationCallback callback, void *context)
+{
+    memset(engine, 0, sizeof(EscalationEngine));
+    engine->system = system;
+    engine->callback = callback;
+    engine->callbackContext = context;
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        countEscalationIncident(engine, incident->type, incident->severity, 1);
+    }
+    return addComplianceMutationListener(system, evaluateEscalationMutation, engine);
+}
+
+/*
+This function stops evaluating the rules of an escalation engine. Queued events can still be polled.
+*/
+void detachEscalationEngine(EscalationEngine *engine)
+{
+    removeComplianceMutationListener(engine->system, evaluateEscalationMutation, engine);
+}
+
+/*
+This function registers an escalation rule, for example {SEVERITY_COUNT_ABOVE, DATA_PRIVACY, 8, 5}
+for more than 5 data privacy incidents of severity 8 or more, or {AVERAGE_SEVERITY_ABOVE,
+EMPLOYMENT_LAWS, 0, 7.5} for an employment law average above 7.5. The rule is inserted into its
+bucket in threshold order. A rule that already holds raises its event right away. It returns the
+id of the rule, or -1 if the rule is invalid or the engine is full.
+*/
+int addEscalationRule(EscalationEngine *engine, EscalationRule rule)
+{
+    if (engine->numRules == MAX_ESCALATION_RULES || (unsigned int)rule.type >= 4 ||
+        (rule.kind == SEVERITY_COUNT_ABOVE && (rule.minSeverity < 1 || rule.minSeverity > 10)) ||
+        (rule.kind != SEVERITY_COUNT_ABOVE && rule.kind != AVERAGE_SEVERITY_ABOVE))
+    {
+        return -1;
+    }
+    int ruleId = engine->numRules++;
+    engine->rules[ruleId] = rule;
+    int bucket = escalationRuleBucket(&rule);
+
+    // Find the position after the rules of the bucket with a threshold up to the new one
+    int position = engine->bucketStart[bucket];
+    while (position < engine->bucketStart[bucket + 1] && engine->rules[engine->ruleOrder[position]].threshold <= rule.threshold)
+    {
+        position++;
+    }
+    memmove(&engine->ruleOrder[position + 1], &engine->ruleOrder[position], (ruleId - position) * sizeof(short));
+    engine->ruleOrder[position] = (short)ruleId;
+    for (int b = bucket + 1; b <= NUM_ESCALATION_BUCKETS; b++)
+    {
+        engine->bucketStart[b]++;
+    }
+
+    // A rule inserted inside the holding prefix holds as well, otherwise the refresh decides
+    if (position < engine->bucketStart[bucket] + engine->bucketHolding[bucket])
+    {
+        engine->bucketHolding[bucket]++;
+        raiseEscalationEvent(engine, ruleId, 0, escalationBucketValue(engine, bucket));
+    }
+    else
+    {
+        refreshEscalationBucket(engine, bucket, 0);
+    }
+    return ruleId;
+}
+
+/*
+This function checks whether an escalation rule currently holds. It returns 1 if it does, and 0
+if it does not or the rule id is unknown.
+*/
+int isEscalationRuleHolding(const EscalationEngine *engine, int ruleId)
+{
+    if (ruleId < 0 || ruleId >= engine->numRules)
+    {
+        return 0;
+    }
+    int bucket = escalationRuleBucket(&engine->rules[ruleId]);
+    int start = engine->bucketStart[bucket];
+    for (int position = start; position < start + engine->bucketHolding[bucket]; position++)
+    {
+        if (engine->ruleOrder[position] == ruleId)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+This function copies up to maxEvents queued escalation events into events, oldest first, and
+removes them from the queue. It returns the number of events copied.
+*/
+int pollEscalationEvents(EscalationEngine *engine, EscalationEvent *events, int maxEvents)
+{
+    int numEvents = 0;
+    while (numEvents < maxEvents && engine->eventHead != engine->eventTail)
+    {
+        events[numEvents++] = engine->events[engine->eventHead % ESCALATION_EVENT_CAPACITY];
+        engine->eventHead++;
+    }
+    return numEvents;
+}
@@ -0,0 +1,274 @@
+#include "filter.h"
+
+// Define the bits of all valid severities, 1 to 10
+#define ALL_SEVERITIES 0x07FE
+
+/*
+This helper appends an empty predicate of the given kind to a filter and returns it, or
+returns NULL if the filter is already full.
+*/
+static FilterPredicate *appendFilterPredicate(IncidentFilter *filter, FilterPredicateKind kind)
+{
+    if (filter->numPredicates == MAX_FILTER_PREDICATES)
+    {
+        return NULL;
+    }
+    FilterPredicate *predicate = &filter->predicates[filter->numPredicates++];
+    memset(predicate, 0, sizeof(FilterPredicate));
+    predicate->kind = kind;
+    return predicate;
+}
+
+/*
+This helper evaluates the type and severity predicates of a compiled filter over a block of
+at most 64 incidents starting at the given position. Every incident costs one table lookup,
+without branches, and sets its bit of the returned selection mask if it passes. The description
+predicates are then checked only for the incidents still selected.
+*/
+static unsigned long long selectIncidentBlock(const CompiledFilter *compiled, const ComplianceManagementSystem *system, int start)
+{
+    int end = start + 64 < system->numIncidents ? start + 64 : system->numIncidents;
+    unsigned long long selection = 0;
+    for (int i = start; i < end; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        unsigned int type = (unsigned int)incident->type;
+        unsigned int severity = (unsigned int)incident->severity;
+        unsigned int allowed = type < 4 && severity <= 10 ? compiled->allowedSeverities[type] : 0;
+        selection |= (unsigned long long)((allowed >> (severity & 15)) & 1) << (i - start);
+    }
+
+    for (int d = 0; d < compiled->numDescriptions && selection != 0; d++)
+    {
+        unsigned long long remaining = selection;
+        while (remaining != 0)
+        {
+            int bit = __builtin_ctzll(remaining);
+            remaining &= remaining - 1;
+            int contains = strstr(system->incidents[start + bit].dataPrivacyIncident.description, compiled->descriptions[d]) != NULL;
+            if (contains == compiled->descriptionNegated[d])
+            {
+                selection &= ~(1ULL << bit);
+            }
+        }
+    }
+    return selection;
+}
+
+/*
+This function initializes a filter without predicates, which matches every incident.
+*/
+void initIncidentFilter(IncidentFilter *filter)
+{
+    filter->numPredicates = 0;
+}
+
+/*
+This function adds a predicate requiring the incident type to be one of a set of types,
+given as FILTER_TYPE bits combined with |. It returns 0 on success and -1 if the filter is full.
+*/
+int filterTypeIn(IncidentFilter *filter, unsigned int typeSet)
+{
+    FilterPredicate *predicate = appendFilterPredicate(filter, PREDICATE_TYPE_IN);
+    if (predicate == NULL)
+    {
+        return -1;
+    }
+    predicate->typeSet = typeSet;
+    return 0;
+}
+
+/*
+This function adds a predicate requiring the incident severity to be between minSeverity
+and maxSeverity, both included. It returns 0 on success and -1 if the filter is full.
+*/
+int filterSeverityBetween(IncidentFilter *filter, int minSeverity, int maxSeverity)
+{
+    FilterPredicate *predicate = appendFilterPredicate(filter, PREDICATE_SEVERITY_BETWEEN);
+    if (predicate == NULL)
+    {
+        return -1;
+    }
+    predicate->minSeverity = minSeverity;
+    predicate->maxSeverity = maxSeverity;
+    return 0;
+}
+
+/*
+This function adds a predicate requiring the incident description to contain a text. It
+returns 0 on success and -1 if the filter is full.
+*/
+int filterDescriptionContains(IncidentFilter *filter, const char *text)
+{
+    FilterPredicate *predicate = appendFilterPredicate(filter, PREDICATE_DESCRIPTION_CONTAINS);
+    if (predicate == NULL)
+    {
+        return -1;
+    }
+    strncpy(predicate->text, text, sizeof(predicate->text) - 1);
+    return 0;
+}
+
+/*
+This function negates the predicate added last to a filter, so for example a type set
+becomes every type outside the set. It returns 0 on success and -1 if the filter is empty.
+*/
+int filterNegateLast(IncidentFilter *filter)
+{
+    if (filter->numPredicates == 0)
+    {
+        return -1;
+    }
+    filter->predicates[filter->numPredicates - 1].negated = !filter->predicates[filter->numPredicates - 1].negated;
+    return 0;
+}
+
+/*
+This function compiles a filter into an evaluation pipeline. All type and severity predicates,
+however many there are, are folded into one table holding the allowed severities of each type,
+so the first stage of the pipeline costs the same for any combination of them. The description
+predicates are kept in a list that is only evaluated for incidents passing the table.
+*/
+void compileIncidentFilter(const IncidentFilter *filter, CompiledFilter *compiled)
+{
+    for (int type = 0; type < 4; type++)
+    {
+        compiled->allowedSeverities[type] = ALL_SEVERITIES;
+    }
+    compiled->numDescriptions = 0;
+
+    for (int p = 0; p < filter->numPredicates; p++)
+    {
+        const FilterPredicate *predicate = &filter->predicates[p];
+        switch (predicate->kind)
+        {
+        case PREDICATE_TYPE_IN:
+            for (int type = 0; type < 4; type++)
+            {
+                int inSet = (predicate->typeSet & FILTER_TYPE(type)) != 0;
+                if (inSet == predicate->negated)
+                {
+                    compiled->allowedSeverities[type] = 0;
+                }
+            }
+            break;
+        case PREDICATE_SEVERITY_BETWEEN:
+        {
+            unsigned short range = 0;
+            for (int severity = 1; severity <= 10; severity++)
+            {
+                if (severity >= predicate->minSeverity && severity <= predicate->maxSeverity)
+                {
+                    range |= (unsigned short)(1u << severity);
+                }
+            }
+            if (predicate->negated)
+            {
+                range = (unsigned short)(~range & ALL_SEVERITIES);
+            }
+            for (int type = 0; type < 4; type++)
+            {
+                compiled->allowedSeverities[type] &= range;
+            }
+            break;
+        }
+        case PREDICATE_DESCRIPTION_CONTAINS:
+            strcpy(compiled->descriptions[compiled->numDescriptions], predicate->text);
+            compiled->descriptionNegated[compiled->numDescriptions] = predicate->negated;
+            compiled->numDescriptions++;
+            break;
+        }
+    }
+}
+
+/*
+This function counts the incidents of a management system matching a compiled filter by
+adding up the population counts of the selection masks.
+*/
+int countMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+    int count = 0;
+    for (int start = 0; start < system->numIncidents; start += 64)
+    {
+        count += __builtin_popcountll(selectIncidentBlock(compiled, system, start));
+    }
+    return count;
+}
+
+/*
+This function calculates the average severity of the incidents matching a compiled filter.
+It returns 0 if no incident matches.
+*/
+float averageSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+    int count = 0;
+    int totalSeverity = 0;
+    for (int start = 0; start < system->numIncidents; start += 64)
+    {
+        unsigned long long selection = selectIncidentBlock(compiled, system, start);
+        count += __builtin_popcountll(selection);
+        while (selection != 0)
+        {
+            int bit = __builtin_ctzll(selection);
+            selection &= selection - 1;
+            totalSeverity += system->incidents[start + bit].dataPrivacyIncident.severity;
+        }
+    }
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return (float)totalSeverity / count;
+}
+
+/*
+This function finds the matching incident with the highest severity. If several match with
+the same severity the first one is returned, like findHighestSeverityIncident does. If no
+incident matches, the function returns an empty incident with a data privacy type, a severity
+of 0 and the message "No matching incidents in the system".
+*/
+ComplianceIncident highestSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+    int highestIndex = -1;
+    int highestSeverity = 0;
+    for (int start = 0; start < system->numIncidents; start += 64)
+    {
+        unsigned long long selection = selectIncidentBlock(compiled, system, start);
+        while (selection != 0)
+        {
+            int bit = __builtin_ctzll(selection);
+            selection &= selection - 1;
+            if (system->incidents[start + bit].dataPrivacyIncident.severity > highestSeverity)
+            {
+                highestSeverity = system->incidents[start + bit].dataPrivacyIncident.severity;
+                highestIndex = start + bit;
+            }
+        }
+    }
+    if (highestIndex == -1)
+    {
+        ComplianceIncident emptyIncident = {DATA_PRIVACY, "No matching incidents in the system", 0};
+        return emptyIncident;
+    }
+    return system->incidents[highestIndex].dataPrivacyIncident;
+}
+
+/*
+This function writes the positions of the incidents matching a compiled filter into indices,
+in order, stopping after maxIndices positions. It returns the number of positions written.
+*/
+int collectMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system, int *indices, int maxIndices)
+{
+    int count = 0;
+    for (int start = 0; start < system->numIncidents && count < maxIndices; start += 64)
+    {
+        unsigned long long selection = selectIncidentBlock(compiled, system, start);
+        while (selection != 0 && count < maxIndices)
+        {
+            int bit = __builtin_ctzll(selection);
+            selection &= selection - 1;
+            indices[count++] = start + bit;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,174 @@
+#include <pthread.h>
+#include "groupby.h"
+
+// Define struct for the range of incidents one thread aggregates
+typedef struct
+{
+    const ComplianceManagementSystem *system;
+    int start;
+    int end;
+    int severityCounts[4][11];
+} GroupByPartial;
+
+/*
+This helper counts the incidents of a range per compliance type and severity. It is the only
+part of a group-by that touches the incidents, and does one counter increment per incident.
+Incidents with an invalid type or severity are skipped.
+*/
+static void countIncidentRange(const ComplianceManagementSystem *system, int start, int end, int severityCounts[4][11])
+{
+    for (int i = start; i < end; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        unsigned int type = (unsigned int)incident->type;
+        unsigned int severity = (unsigned int)incident->severity;
+        if (type < 4 && severity >= 1 && severity <= 10)
+        {
+            severityCounts[type][severity]++;
+        }
+    }
+}
+
+/*
+This helper is the thread entry point of a parallel group-by.
+*/
+static void *countIncidentRangeThread(void *argument)
+{
+    GroupByPartial *partial = (GroupByPartial *)argument;
+    countIncidentRange(partial->system, partial->start, partial->end, partial->severityCounts);
+    return NULL;
+}
+
+/*
+This helper derives count, total, minimum, maximum and mean of every group of a result table
+from its severity counts.
+*/
+static void finishSeverityGroups(SeverityGroupTable *table)
+{
+    for (int type = 0; type < 4; type++)
+    {
+        SeverityGroup *group = &table->groups[type];
+        group->count = 0;
+        group->totalSeverity = 0;
+        group->minSeverity = 0;
+        group->maxSeverity = 0;
+        for (int severity = 1; severity <= 10; severity++)
+        {
+            if (group->severityCounts[severity] == 0)
+            {
+                continue;
+            }
+            if (group->minSeverity == 0)
+            {
+                group->minSeverity = severity;
+            }
+            group->maxSeverity = severity;
+            group->count += group->severityCounts[severity];
+            group->totalSeverity += severity * group->severityCounts[severity];
+        }
+        group->meanSeverity = group->count > 0 ? (float)group->totalSeverity / group->count : 0.0f;
+    }
+}
+
+/*
+This helper copies per-type severity counts into the groups of a result table and finishes it.
+*/
+static void fillSeverityGroupTable(SeverityGroupTable *table, int severityCounts[4][11])
+{
+    for (int type = 0; type < 4; type++)
+    {
+        memcpy(table->groups[type].severityCounts, severityCounts[type], sizeof(table->groups[type].severityCounts));
+    }
+    finishSeverityGroups(table);
+}
+
+/*
+This function computes the count, total, minimum, maximum, mean and full severity distribution
+of every compliance type in one pass over the incidents of a management system. The pass only
+counts incidents per type and severity; everything else is derived from those counts afterwards.
+The system is passed by pointer so nothing is copied.
+*/
+void groupIncidentsByType(const ComplianceManagementSystem *system, SeverityGroupTable *table)
+{
+    int severityCounts[4][11];
+    memset(severityCounts, 0, sizeof(severityCounts));
+    countIncidentRange(system, 0, system->numIncidents, severityCounts);
+    fillSeverityGroupTable(table, severityCounts);
+}
+
+/*
+This function computes the same result table as groupIncidentsByType, but splits the incidents
+into one contiguous range per thread. Every thread counts its range into its own partial counts,
+and the partial counts are added up once all threads have finished. The number of threads is
+clamped to between 1 and MAX_GROUP_BY_THREADS. The function returns 0 on success and -1 if a
+thread could not be started, in which case the table is computed on the calling thread instead.
+*/
+int groupIncidentsByTypeParallel(const ComplianceManagementSystem *system, SeverityGroupTable *table, int numThreads)
+{
+    if (numThreads < 1)
+    {
+        numThreads = 1;
+    }
+    if (numThreads > MAX_GROUP_BY_THREADS)
+    {
+        numThreads = MAX_GROUP_BY_THREADS;
+    }
+
+    GroupByPartial partials[MAX_GROUP_BY_THREADS];
+    pthread_t threads[MAX_GROUP_BY_THREADS];
+    int numStarted = 0;
+    int failed = 0;
+    int rangeSize = (system->numIncidents + numThreads - 1) / numThreads;
+    for (int t = 0; t < numThreads; t++)
+    {
+        partials[t].system = system;
+        partials[t].start = t * rangeSize < system->numIncidents ? t * rangeSize : system->numIncidents;
+        partials[t].end = partials[t].start + rangeSize < system->numIncidents ? partials[t].start + rangeSize : system->numIncidents;
+        memset(partials[t].severityCounts, 0, sizeof(partials[t].severityCounts));
+        if (pthread_create(&threads[t], NULL, countIncidentRangeThread, &partials[t]) != 0)
+        {
+            failed = 1;
+            break;
+        }
+        numStarted++;
+    }
+
+    // Wait for every thread and add up the partial counts
+    int severityCounts[4][11];
+    memset(severityCounts, 0, sizeof(severityCounts));
+    for (int t = 0; t < numStarted; t++)
+    {
+        pthread_join(threads[t], NULL);
+        for (int type = 0; type < 4; type++)
+        {
+            for (int severity = 0; severity <= 10; severity++)
+            {
+                severityCounts[type][severity] += partials[t].severityCounts[type][severity];
+            }
+        }
+    }
+    if (failed)
+    {
+        groupIncidentsByType(system, table);
+        return -1;
+    }
+    fillSeverityGroupTable(table, severityCounts);
+    return 0;
+}
+
+/*
+This function merges the severity statistics of one result table into another, for example
+to combine the tables of several management systems. The severity distributions are added up
+and every other statistic is derived again from them.
+*/
+void mergeSeverityGroupTables(SeverityGroupTable *table, const SeverityGroupTable *other)
+{
+    for (int type = 0; type < 4; type++)
+    {
+        for (int severity = 1; severity <= 10; severity++)
+        {
+            table->groups[type].severityCounts[severity] += other->groups[type].severityCounts[severity];
+        }
+    }
+    finishSeverityGroups(table);
+}
@@ -0,0 +1,474 @@
+#include "history.h"
+
+/*
+This helper returns the slot where the probe for a type and description hash starts in the key table.
+*/
+static int homeSeverityHistorySlot(const SeverityHistory *history, ComplianceType type, unsigned long long hash)
+{
+    return (int)((hash + (unsigned long long)type) & (unsigned long long)(history->numSlots - 1));
+}
+
+/*
+This helper finds the slot of an incident in the key table. A slot only matches if the type, the
+full 64-bit description hash and the description itself are all equal, so descriptions whose
+hashes collide still get keys of their own. It returns the slot holding the key, or the empty
+slot where the key would go.
+*/
+static int findSeverityHistorySlot(const SeverityHistory *history, ComplianceType type, unsigned long long hash, const char *description)
+{
+    int slot = homeSeverityHistorySlot(history, type, hash);
+    for (int key = history->keySlots[slot]; key != -1; key = history->keySlots[slot])
+    {
+        if (history->keyHashes[key] == hash && history->keyTypes[key] == (unsigned char)type &&
+            strncmp(history->keyDescriptions[key], description, 100) == 0)
+        {
+            break;
+        }
+        slot = (slot + 1) & (history->numSlots - 1);
+    }
+    return slot;
+}
+
+/*
+This helper doubles the key table and reinserts every key. The keys are distinct, so each one
+goes into the first empty slot of its probe. It returns 0 on success and -1 if the memory could
+not be allocated, in which case the table is left untouched.
+*/
+static int growSeverityHistorySlots(SeverityHistory *history)
+{
+    int newNumSlots = history->numSlots * 2;
+    int *newSlots = (int *)malloc((size_t)newNumSlots * sizeof(int));
+    if (newSlots == NULL)
+    {
+        return -1;
+    }
+    memset(newSlots, 0xFF, (size_t)newNumSlots * sizeof(int));
+    free(history->keySlots);
+    history->keySlots = newSlots;
+    history->numSlots = newNumSlots;
+    for (int key = 0; key < history->numKeys; key++)
+    {
+        int slot = homeSeverityHistorySlot(history, (ComplianceType)history->keyTypes[key], history->keyHashes[key]);
+        while (history->keySlots[slot] != -1)
+        {
+            slot = (slot + 1) & (newNumSlots - 1);
+        }
+        history->keySlots[slot] = key;
+    }
+    return 0;
+}
+
+/*
+This helper finds the key of an incident, adding a key with its own copy of the description the
+first time a type and description are seen. It returns the key, or -1 if the memory could not be
+allocated.
+*/
+static int findOrAddSeverityHistoryKey(SeverityHistory *history, ComplianceType type, const char *description)
+{
+    unsigned long long hash = hashIncidentDescription(description);
+    if (2 * (history->numKeys + 1) > history->numSlots && growSeverityHistorySlots(history) != 0)
+    {
+        return -1;
+    }
+    int slot = findSeverityHistorySlot(history, type, hash, description);
+    if (history->keySlots[slot] != -1)
+    {
+        return history->keySlots[slot];
+    }
+    if (history->numKeys == history->keyCapacity)
+    {
+        int newCapacity = history->keyCapacity * 2;
+        void *keyHashes = realloc(history->keyHashes, (size_t)newCapacity * sizeof(unsigned long long));
+        if (keyHashes != NULL)
+        {
+            history->keyHashes = (unsigned long long *)keyHashes;
+        }
+        void *keyTypes = realloc(history->keyTypes, (size_t)newCapacity);
+        if (keyTypes != NULL)
+        {
+            history->keyTypes = (unsigned char *)keyTypes;
+        }
+        void *keyDescriptions = realloc(history->keyDescriptions, (size_t)newCapacity * sizeof(char *));
+        if (keyDescriptions != NULL)
+        {
+            history->keyDescriptions = (char **)keyDescriptions;
+        }
+        void *latestEntries = realloc(history->latestEntries, (size_t)newCapacity * sizeof(int));
+        if (latestEntries != NULL)
+        {
+            history->latestEntries = (int *)latestEntries;
+        }
+        if (keyHashes == NULL || keyTypes == NULL || keyDescriptions == NULL || latestEntries == NULL)
+        {
+            return -1;
+        }
+        history->keyCapacity = newCapacity;
+    }
+    size_t length = strnlen(description, 100);
+    char *copy = (char *)malloc(length + 1);
+    if (copy == NULL)
+    {
+        return -1;
+    }
+    memcpy(copy, description, length);
+    copy[length] = '\0';
+    int key = history->numKeys++;
+    history->keyHashes[key] = hash;
+    history->keyTypes[key] = (unsigned char)type;
+    history->keyDescriptions[key] = copy;
+    history->latestEntries[key] = -1;
+    history->keySlots[slot] = key;
+    return key;
+}
+
+/*
+This helper makes sure the entry columns and the checkpoints have room for one more element,
+doubling the capacity of whichever is full. It returns 0 on success and -1 if the memory could
+not be allocated, in which case the capacities are left unchanged.
+*/
+static int reserveSeverityHistoryEntry(SeverityHistory *history)
+{
+    if (history->numEntries == history->capacity)
+    {
+        int newCapacity = history->capacity * 2;
+        void *sequenceDeltas = realloc(history->sequenceDeltas, (size_t)newCapacity * sizeof(unsigned short));
+        if (sequenceDeltas != NULL)
+        {
+            history->sequenceDeltas = (unsigned short *)sequenceDeltas;
+        }
+        void *severities = realloc(history->severities, (size_t)newCapacity);
+        if (severities != NULL)
+        {
+            history->severities = (unsigned char *)severities;
+        }
+        void *keys = realloc(history->keys, (size_t)newCapacity * sizeof(int));
+        if (keys != NULL)
+        {
+            history->keys = (int *)keys;
+        }
+        void *previousEntries = realloc(history->previousEntries, (size_t)newCapacity * sizeof(int));
+        if (previousEntries != NULL)
+        {
+            history->previousEntries = (int *)previousEntries;
+        }
+        if (sequenceDeltas == NULL || severities == NULL || keys == NULL || previousEntries == NULL)
+        {
+            return -1;
+        }
+        history->capacity = newCapacity;
+    }
+    if (history->numCheckpoints == history->checkpointCapacity)
+    {
+        int newCapacity = history->checkpointCapacity * 2;
+        void *checkpoints = realloc(history->checkpoints, (size_t)newCapacity * sizeof(SeverityCheckpoint));
+        if (checkpoints == NULL)
+        {
+            return -1;
+        }
+        history->checkpoints = (SeverityCheckpoint *)checkpoints;
+        history->checkpointCapacity = newCapacity;
+    }
+    return 0;
+}
+
+/*
+This helper applies one history entry to an aggregate. An entry from severity 0 adds an
+incident, an entry to severity 0 removes one, and any other entry only changes the total.
+*/
+static void applySeverityHistoryEntry(const SeverityHistory *history, int entry, SeverityAggregate *aggregate)
+{
+    int type = history->keyTypes[history->keys[entry]];
+    int oldSeverity = history->severities[entry] >> 4;
+    int newSeverity = history->severities[entry] & 0x0F;
+    aggregate->numIncidents[type] += (oldSeverity == 0) - (newSeverity == 0);
+    aggregate->totalSeverity[type] += newSeverity - oldSeverity;
+}
+
+/*
+This helper appends one change to the history. A checkpoint holding the absolute sequence and
+the aggregate so far is written every SEVERITY_HISTORY_CHECKPOINT_INTERVAL entries, and earlier
+if the distance to the previous entry does not fit in a sequence delta. Changes with a type or
+severity that cannot be encoded are left out, and changes that find no memory are counted as
+dropped.
+*/
+static void appendSeverityHistoryEntry(SeverityHistory *history, unsigned long sequence, ComplianceType type, const char *description, int oldSeverity, int newSeverity)
+{
+    if ((unsigned int)type >= 4 || oldSeverity < 0 || oldSeverity > 15 || newSeverity < 0 || newSeverity > 15)
+    {
+        return;
+    }
+    int key = reserveSeverityHistoryEntry(history) == 0 ? findOrAddSeverityHistoryKey(history, type, description) : -1;
+    if (key == -1)
+    {
+        history->numDroppedEntries++;
+        return;
+    }
+    int entry = history->numEntries;
+    int checkpoint = history->numCheckpoints - 1;
+    if (checkpoint < 0 || entry - history->checkpoints[checkpoint].firstEntry == SEVERITY_HISTORY_CHECKPOINT_INTERVAL ||
+        sequence - history->lastSequence > 0xFFFF)
+    {
+        SeverityCheckpoint *newCheckpoint = &history->checkpoints[history->numCheckpoints++];
+        newCheckpoint->firstEntry = entry;
+        newCheckpoint->sequence = sequence;
+        newCheckpoint->aggregate = history->aggregate;
+        history->sequenceDeltas[entry] = 0;
+    }
+    else
+    {
+        history->sequenceDeltas[entry] = (unsigned short)(sequence - history->lastSequence);
+    }
+    history->keys[entry] = key;
+    history->severities[entry] = (unsigned char)(oldSeverity << 4 | newSeverity);
+    history->previousEntries[entry] = history->latestEntries[key];
+    history->latestEntries[key] = entry;
+    history->numEntries++;
+    history->lastSequence = sequence;
+    applySeverityHistoryEntry(history, entry, &history->aggregate);
+}
+
+/*
+This helper is the mutation listener of a severity history. An add is recorded as a change from
+severity 0, a removal or tombstone as a change to severity 0. Compacting a tombstone changes
+nothing that the history records.
+*/
+static void recordSeverityHistoryMutation(void *context, const ComplianceMutation *mutation)
+{
+    SeverityHistory *history = (SeverityHistory *)context;
+    const ComplianceIncident *incident = mutation->incident;
+    switch (mutation->kind)
+    {
+    case INCIDENT_ADDED:
+        appendSeverityHistoryEntry(history, mutation->sequence, incident->type, incident->description, 0, incident->severity);
+        break;
+    case INCIDENT_SEVERITY_UPDATED:
+        appendSeverityHistoryEntry(history, mutation->sequence, incident->type, incident->description, mutation->oldSeverity, incident->severity);
+        break;
+    case INCIDENT_REMOVED:
+    case INCIDENT_TOMBSTONED:
+        appendSeverityHistoryEntry(history, mutation->sequence, incident->type, incident->description, mutation->oldSeverity, 0);
+        break;
+    case INCIDENT_COMPACTED:
+        break;
+    }
+}
+
+/*
+This helper finds the last entry recorded at or before a version. The checkpoints are searched
+by binary search, then the sequence deltas after the checkpoint are added up, so at most
+SEVERITY_HISTORY_CHECKPOINT_INTERVAL entries are visited. If aggregate is not NULL, it receives
+the aggregate as of the version. It returns -1 if no entry is that old.
+*/
+static int findSeverityHistoryEntryAsOf(const SeverityHistory *history, unsigned long version, SeverityAggregate *aggregate)
+{
+    if (aggregate != NULL)
+    {
+        memset(aggregate, 0, sizeof(SeverityAggregate));
+    }
+    int low = 0;
+    int high = history->numCheckpoints - 1;
+    int checkpoint = -1;
+    while (low <= high)
+    {
+        int middle = (low + high) / 2;
+        if (history->checkpoints[middle].sequence <= version)
+        {
+            checkpoint = middle;
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    if (checkpoint == -1)
+    {
+        return -1;
+    }
+    if (aggregate != NULL)
+    {
+        *aggregate = history->checkpoints[checkpoint].aggregate;
+    }
+    int end = checkpoint + 1 < history->numCheckpoints ? history->checkpoints[checkpoint + 1].firstEntry : history->numEntries;
+    int entry = history->checkpoints[checkpoint].firstEntry;
+    unsigned long sequence = history->checkpoints[checkpoint].sequence;
+    while (1)
+    {
+        if (aggregate != NULL)
+        {
+            applySeverityHistoryEntry(history, entry, aggregate);
+        }
+        if (entry + 1 == end || sequence + history->sequenceDeltas[entry + 1] > version)
+        {
+            return entry;
+        }
+        entry++;
+        sequence += history->sequenceDeltas[entry];
+    }
+}
+
+/*
+This function starts recording the severity history of a management system. The incidents
+already in the system are recorded as added at version 0, and every later add, severity update
+and removal is appended by a mutation listener with the sequence of the mutation as its version.
+Each change takes 11 bytes spread over four columns, instead of a copy of the incident; only
+the first change of each type and description also stores a copy of the description in the key
+columns. It returns 0 on success and -1 if the memory could not be allocated or no more
+listeners can be registered.
+*/
+int attachSeverityHistory(SeverityHistory *history, ComplianceManagementSystem *system)
+{
+    memset(history, 0, sizeof(SeverityHistory));
+    history->system = system;
+    history->capacity = 128;
+    history->checkpointCapacity = 8;
+    history->keyCapacity = 64;
+    history->numSlots = 256;
+    history->sequenceDeltas = (unsigned short *)malloc(history->capacity * sizeof(unsigned short));
+    history->severities = (unsigned char *)malloc(history->capacity);
+    history->keys = (int *)malloc(history->capacity * sizeof(int));
+    history->previousEntries = (int *)malloc(history->capacity * sizeof(int));
+    history->checkpoints = (SeverityCheckpoint *)malloc(history->checkpointCapacity * sizeof(SeverityCheckpoint));
+    history->keyHashes = (unsigned long long *)malloc(history->keyCapacity * sizeof(unsigned long long));
+    history->keyTypes = (unsigned char *)malloc(history->keyCapacity);
+    history->keyDescriptions = (char **)malloc(history->keyCapacity * sizeof(char *));
+    history->latestEntries = (int *)malloc(history->keyCapacity * sizeof(int));
+    history->keySlots = (int *)malloc(history->numSlots * sizeof(int));
+    if (history->sequenceDeltas == NULL || history->severities == NULL || history->keys == NULL ||
+        history->previousEntries == NULL || history->checkpoints == NULL || history->keyHashes == NULL ||
+        history->keyTypes == NULL || history->keyDescriptions == NULL || history->latestEntries == NULL ||
+        history->keySlots == NULL)
+    {
+        destroySeverityHistory(history);
+        return -1;
+    }
+    memset(history->keySlots, 0xFF, history->numSlots * sizeof(int));
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        const ComplianceIncident *incident = &system->incidents[i].dataPrivacyIncident;
+        appendSeverityHistoryEntry(history, 0, incident->type, incident->description, 0, incident->severity);
+    }
+    if (addComplianceMutationListener(system, recordSeverityHistoryMutation, history) != 0)
+    {
+        destroySeverityHistory(history);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+This function stops recording the severity history of a management system. The history
+recorded so far can still be queried until it is destroyed.
+*/
+void detachSeverityHistory(SeverityHistory *history)
+{
+    removeComplianceMutationListener(history->system, recordSeverityHistoryMutation, history);
+}
+
+/*
+This function releases the memory owned by a severity history. The history must be detached first.
+*/
+void destroySeverityHistory(SeverityHistory *history)
+{
+    free(history->sequenceDeltas);
+    free(history->severities);
+    free(history->keys);
+    free(history->previousEntries);
+    free(history->checkpoints);
+    for (int key = 0; key < history->numKeys; key++)
+    {
+        free(history->keyDescriptions[key]);
+    }
+    free(history->keyHashes);
+    free(history->keyTypes);
+    free(history->keyDescriptions);
+    free(history->latestEntries);
+    free(history->keySlots);
+    memset(history, 0, sizeof(SeverityHistory));
+}
+
+/*
+This function returns the version of the latest change recorded in a severity history, which
+can be kept to query the state of the system at this point later on.
+*/
+unsigned long currentSeverityHistoryVersion(const SeverityHistory *history)
+{
+    return history->lastSequence;
+}
+
+/*
+This function finds the severity the incident with a given type and description had as of a
+version, that is after every change up to and including that version. The last entry at or
+before the version is located through the checkpoints, then the chain of entries of the
+incident is followed back from that entry to its first one, counting the incidents alive with
+each severity, without rebuilding any past state. Identical incidents share one chain, so if
+several were alive at that version the highest of their severities is returned, and removing one
+of them leaves the others in place. It returns 0 if no such incident was in the system at that
+version.
+*/
+int severityAsOf(const SeverityHistory *history, ComplianceType type, const char *description, unsigned long version)
+{
+    if ((unsigned int)type >= 4 || history->numEntries == 0)
+    {
+        return 0;
+    }
+    int key = history->keySlots[findSeverityHistorySlot(history, type, hashIncidentDescription(description), description)];
+    if (key == -1)
+    {
+        return 0;
+    }
+    int lastEntry = findSeverityHistoryEntryAsOf(history, version, NULL);
+    int entry = history->latestEntries[key];
+    while (entry > lastEntry)
+    {
+        entry = history->previousEntries[entry];
+    }
+
+    // Each entry moves one incident from its old severity to its new one, 0 meaning absent
+    int counts[11] = {0};
+    for (; entry != -1; entry = history->previousEntries[entry])
+    {
+        counts[history->severities[entry] & 0x0F]++;
+        counts[history->severities[entry] >> 4]--;
+    }
+    for (int severity = 10; severity >= 1; severity--)
+    {
+        if (counts[severity] > 0)
+        {
+            return severity;
+        }
+    }
+    return 0;
+}
+
+/*
+This function computes the number of incidents of each type and their total severity as of a
+version, by replaying the entries after the nearest checkpoint on top of its aggregate.
+*/
+SeverityAggregate aggregateSeverityAsOf(const SeverityHistory *history, unsigned long version)
+{
+    SeverityAggregate aggregate;
+    findSeverityHistoryEntryAsOf(history, version, &aggregate);
+    return aggregate;
+}
+
+/*
+This function calculates the average severity of all incidents as of a version. It returns 0
+if there were no incidents at that version.
+*/
+float calculateAverageSeverityAsOf(const SeverityHistory *history, unsigned long version)
+{
+    SeverityAggregate aggregate = aggregateSeverityAsOf(history, version);
+    int numIncidents = 0;
+    int totalSeverity = 0;
+    for (int type = 0; type < 4; type++)
+    {
+        numIncidents += aggregate.numIncidents[type];
+        totalSeverity += aggregate.totalSeverity[type];
+    }
+    if (numIncidents == 0)
+    {
+        return 0.0;
+    }
+    return (float)totalSeverity / numIncidents;
+}
@@ -0,0 +1,193 @@
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "sharedstore.h"
+
+/*
+This helper returns the current time of the monotonic clock in milliseconds.
+*/
+static long long sharedStoreMilliseconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/*
+This function creates a POSIX shared memory segment with the given name, sizes it for one
+management system and maps it for reading and writing. The system starts out empty. The name
+must start with a slash, as required by shm_open. A segment that already exists is never reset,
+since readers may be using it, so a second writer cannot take over a live store. It returns 0 on
+success and -1 if the segment already exists or could not be created or mapped.
+*/
+int createSharedStore(SharedStore *store, const char *name)
+{
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(SharedStoreSegment)) == -1)
+    {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    void *address = mmap(NULL, sizeof(SharedStoreSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        shm_unlink(name);
+        return -1;
+    }
+
+    store->segment = (SharedStoreSegment *)address;
+    store->writer = 1;
+    strncpy(store->name, name, sizeof(store->name) - 1);
+    store->name[sizeof(store->name) - 1] = '\0';
+
+    store->segment->segmentSize = sizeof(SharedStoreSegment);
+    store->segment->sequence = 0;
+    store->segment->system.numIncidents = 0;
+    __atomic_store_n(&store->segment->magic, SHARED_STORE_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/*
+This function maps an existing shared store segment read-only. It checks that the segment
+was initialized by a writer and has the layout this process expects. It returns 0 on success
+and -1 if the segment does not exist, could not be mapped or does not match.
+*/
+int openSharedStore(SharedStore *store, const char *name)
+{
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd == -1)
+    {
+        return -1;
+    }
+    void *address = mmap(NULL, sizeof(SharedStoreSegment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    SharedStoreSegment *segment = (SharedStoreSegment *)address;
+    if (__atomic_load_n(&segment->magic, __ATOMIC_ACQUIRE) != SHARED_STORE_MAGIC ||
+        segment->segmentSize != sizeof(SharedStoreSegment))
+    {
+        munmap(address, sizeof(SharedStoreSegment));
+        return -1;
+    }
+    store->segment = segment;
+    store->writer = 0;
+    strncpy(store->name, name, sizeof(store->name) - 1);
+    store->name[sizeof(store->name) - 1] = '\0';
+    return 0;
+}
+
+/*
+This function unmaps the shared store segment of a handle. The segment itself stays
+available to other processes until it is unlinked.
+*/
+void closeSharedStore(SharedStore *store)
+{
+    if (store->segment != NULL)
+    {
+        munmap(store->segment, sizeof(SharedStoreSegment));
+        store->segment = NULL;
+    }
+}
+
+/*
+This function removes the name of a shared store segment. Processes that still have it
+mapped keep their mapping. It returns 0 on success and -1 otherwise.
+*/
+int unlinkSharedStore(const char *name)
+{
+    return shm_unlink(name);
+}
+
+/*
+This function starts changing the system of a shared store. It makes the sequence odd so that
+readers retry instead of using a half-changed system, and returns the shared system so it can be
+passed to the existing functions such as addComplianceIncident. Every call must be followed by
+endSharedStoreWrite. Only the process that created the store may write; for readers the function
+returns NULL.
+*/
+ComplianceManagementSystem *beginSharedStoreWrite(SharedStore *store)
+{
+    if (!store->writer)
+    {
+        return NULL;
+    }
+    unsigned long sequence = __atomic_load_n(&store->segment->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&store->segment->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return &store->segment->system;
+}
+
+/*
+This function publishes the changes made since beginSharedStoreWrite by making the sequence
+even again.
+*/
+void endSharedStoreWrite(SharedStore *store)
+{
+    if (!store->writer)
+    {
+        return;
+    }
+    unsigned long sequence = __atomic_load_n(&store->segment->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&store->segment->sequence, sequence + 1, __ATOMIC_RELEASE);
+}
+
+/*
+This function copies a consistent snapshot of the system of a shared store. It copies only the
+incidents in use, and retries whenever the writer was active before or during the copy. If the
+writer stays active for longer than SHARED_STORE_READ_TIMEOUT_MILLISECONDS, for example because
+its process died between beginSharedStoreWrite and endSharedStoreWrite, the function gives up
+instead of waiting forever. The snapshot can then be passed to the existing functions such as
+calculateAverageSeverity and findHighestSeverityIncident. It returns 0 on success and -1 on a
+timeout, in which case the snapshot must not be used.
+*/
+int readSharedStore(const SharedStore *store, ComplianceManagementSystem *snapshot)
+{
+    const SharedStoreSegment *segment = store->segment;
+    long long deadline = 0;
+    for (int attempt = 0;; attempt++)
+    {
+        // Spin briefly first, then yield and watch the clock once the writer takes longer
+        if (attempt >= 64)
+        {
+            long long now = sharedStoreMilliseconds();
+            if (deadline == 0)
+            {
+                deadline = now + SHARED_STORE_READ_TIMEOUT_MILLISECONDS;
+            }
+            else if (now >= deadline)
+            {
+                return -1;
+            }
+            sched_yield();
+        }
+        unsigned long sequence = __atomic_load_n(&segment->sequence, __ATOMIC_ACQUIRE);
+        if (sequence & 1)
+        {
+            continue;
+        }
+        int numIncidents = segment->system.numIncidents;
+        if (numIncidents < 0 || numIncidents > 100)
+        {
+            numIncidents = 0;
+        }
+        memcpy(snapshot->incidents, segment->system.incidents, numIncidents * sizeof(ComplianceIncidentUnion));
+        snapshot->numIncidents = numIncidents;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&segment->sequence, __ATOMIC_RELAXED) == sequence)
+        {
+            return 0;
+        }
+    }
+}
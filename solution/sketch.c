@@ -0,0 +1,477 @@
+#include <math.h>
+#include "sketch.h"
+
+// Define the value identifying serialized description sketches
+#define SKETCH_MAGIC 0x4B53444D
+
+/*
+This helper finds the column of a Count-Min row for a description hash, deriving one hash
+per row from the two halves of the 64-bit description hash.
+*/
+static int countMinColumn(const DescriptionSketches *sketches, unsigned long long hash, int row)
+{
+    unsigned int first = (unsigned int)hash;
+    unsigned int second = (unsigned int)(hash >> 32) | 1;
+    return (int)((first + (unsigned int)row * second) % (unsigned int)sketches->countMinWidth);
+}
+
+/*
+This helper estimates the count of a description hash as the smallest of its Count-Min counters.
+*/
+static unsigned int countMinEstimate(const DescriptionSketches *sketches, const TypeSketch *sketch, unsigned long long hash)
+{
+    unsigned int estimate = 0xFFFFFFFFu;
+    for (int row = 0; row < sketches->countMinDepth; row++)
+    {
+        unsigned int count = sketch->counts[row][countMinColumn(sketches, hash, row)];
+        if (count < estimate)
+        {
+            estimate = count;
+        }
+    }
+    return estimate;
+}
+
+/*
+This helper restores the min-heap order of the heavy hitters of a sketch by moving an entry
+down towards the leaves.
+*/
+static void siftHeavyHitterDown(TypeSketch *sketch, int index)
+{
+    for (;;)
+    {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < sketch->numTopK && sketch->topK[left].count < sketch->topK[smallest].count)
+        {
+            smallest = left;
+        }
+        if (right < sketch->numTopK && sketch->topK[right].count < sketch->topK[smallest].count)
+        {
+            smallest = right;
+        }
+        if (smallest == index)
+        {
+            return;
+        }
+        HeavyHitter heavyHitter = sketch->topK[index];
+        sketch->topK[index] = sketch->topK[smallest];
+        sketch->topK[smallest] = heavyHitter;
+        index = smallest;
+    }
+}
+
+/*
+This helper restores the min-heap order of the heavy hitters of a sketch by moving an entry
+up towards the root.
+*/
+static void siftHeavyHitterUp(TypeSketch *sketch, int index)
+{
+    while (index > 0 && sketch->topK[(index - 1) / 2].count > sketch->topK[index].count)
+    {
+        HeavyHitter heavyHitter = sketch->topK[index];
+        sketch->topK[index] = sketch->topK[(index - 1) / 2];
+        sketch->topK[(index - 1) / 2] = heavyHitter;
+        index = (index - 1) / 2;
+    }
+}
+
+/*
+This helper offers a description with its estimated count to the heavy hitters of a sketch.
+A description already in the heap gets its count updated; otherwise it is inserted if the heap
+is not full yet, or replaces the least frequent heavy hitter if it is now more frequent.
+*/
+static void offerHeavyHitter(TypeSketch *sketch, unsigned long long hash, const char *description, unsigned int count)
+{
+    for (int i = 0; i < sketch->numTopK; i++)
+    {
+        if (sketch->topK[i].hash == hash && strcmp(sketch->topK[i].description, description) == 0)
+        {
+            sketch->topK[i].count = count;
+            siftHeavyHitterDown(sketch, i);
+            return;
+        }
+    }
+    int index;
+    if (sketch->numTopK < SKETCH_TOP_K)
+    {
+        index = sketch->numTopK++;
+    }
+    else if (count > sketch->topK[0].count)
+    {
+        index = 0;
+    }
+    else
+    {
+        return;
+    }
+    strncpy(sketch->topK[index].description, description, 99);
+    sketch->topK[index].description[99] = '\0';
+    sketch->topK[index].hash = hash;
+    sketch->topK[index].count = count;
+    siftHeavyHitterUp(sketch, index);
+    siftHeavyHitterDown(sketch, index);
+}
+
+/*
+This helper sorts heavy hitters by count, most frequent first.
+*/
+static void sortHeavyHitters(HeavyHitter *heavyHitters, int numHeavyHitters)
+{
+    for (int i = 1; i < numHeavyHitters; i++)
+    {
+        for (int j = i; j > 0 && heavyHitters[j - 1].count < heavyHitters[j].count; j--)
+        {
+            HeavyHitter heavyHitter = heavyHitters[j];
+            heavyHitters[j] = heavyHitters[j - 1];
+            heavyHitters[j - 1] = heavyHitter;
+        }
+    }
+}
+
+/*
+This helper is the mutation listener of description sketches. Only added incidents are
+counted; the sketches cannot forget descriptions, so updates and removals are ignored.
+*/
+static void recordSketchMutation(void *context, const ComplianceMutation *mutation)
+{
+    if (mutation->kind == INCIDENT_ADDED)
+    {
+        addDescriptionToSketches((DescriptionSketches *)context, mutation->incident->type, mutation->incident->description);
+    }
+}
+
+/*
+These helpers write and read little-endian integers of the serialized format.
+*/
+static void writeSketchInteger(unsigned char **position, unsigned long long value, int numBytes)
+{
+    for (int i = 0; i < numBytes; i++)
+    {
+        *(*position)++ = (unsigned char)(value >> (8 * i));
+    }
+}
+
+static unsigned long long readSketchInteger(const unsigned char **position, int numBytes)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < numBytes; i++)
+    {
+        value |= (unsigned long long)*(*position)++ << (8 * i);
+    }
+    return value;
+}
+
+/*
+This function initializes empty description sketches. The HyperLogLog precision sets the error
+of distinct counts and the Count-Min width and depth set the error of frequency estimates, at a
+memory cost of 2^hllPrecision bytes and countMinWidth * countMinDepth counters per type. It
+returns 0 on success and -1 if a parameter is outside 4 to MAX_HLL_PRECISION, 1 to
+MAX_COUNT_MIN_WIDTH or 1 to MAX_COUNT_MIN_DEPTH.
+*/
+int initDescriptionSketches(DescriptionSketches *sketches, int hllPrecision, int countMinWidth, int countMinDepth)
+{
+    if (hllPrecision < 4 || hllPrecision > MAX_HLL_PRECISION || countMinWidth < 1 ||
+        countMinWidth > MAX_COUNT_MIN_WIDTH || countMinDepth < 1 || countMinDepth > MAX_COUNT_MIN_DEPTH)
+    {
+        return -1;
+    }
+    memset(sketches, 0, sizeof(DescriptionSketches));
+    sketches->hllPrecision = hllPrecision;
+    sketches->countMinWidth = countMinWidth;
+    sketches->countMinDepth = countMinDepth;
+    return 0;
+}
+
+/*
+This function registers description sketches as a mutation listener of a management system,
+so every incident accepted by addComplianceIncident is added to the sketches of its type. It
+returns 0 on success and -1 if no more listeners can be registered.
+*/
+int attachDescriptionSketches(DescriptionSketches *sketches, ComplianceManagementSystem *system)
+{
+    sketches->system = system;
+    return addComplianceMutationListener(system, recordSketchMutation, sketches);
+}
+
+/*
+This function stops feeding description sketches from their management system. The sketches
+keep everything they have seen so far.
+*/
+void detachDescriptionSketches(DescriptionSketches *sketches)
+{
+    removeComplianceMutationListener(sketches->system, recordSketchMutation, sketches);
+    sketches->system = NULL;
+}
+
+/*
+This function adds one description of a certain type to description sketches. The description
+hash updates one HyperLogLog register with the position of its first set bit, increments one
+Count-Min counter per row, and the new count estimate is offered to the heavy hitters.
+*/
+void addDescriptionToSketches(DescriptionSketches *sketches, ComplianceType type, const char *description)
+{
+    if ((unsigned int)type >= 4)
+    {
+        return;
+    }
+    TypeSketch *sketch = &sketches->types[type];
+    unsigned long long hash = hashIncidentDescription(description);
+
+    // Update the HyperLogLog register selected by the top bits of the hash
+    int precision = sketches->hllPrecision;
+    int registerIndex = (int)(hash >> (64 - precision));
+    unsigned long long remainingBits = hash << precision;
+    int rank = remainingBits == 0 ? 64 - precision + 1 : __builtin_clzll(remainingBits) + 1;
+    if (rank > sketch->registers[registerIndex])
+    {
+        sketch->registers[registerIndex] = (unsigned char)rank;
+    }
+
+    // Update the Count-Min counters and the heavy hitters
+    for (int row = 0; row < sketches->countMinDepth; row++)
+    {
+        sketch->counts[row][countMinColumn(sketches, hash, row)]++;
+    }
+    offerHeavyHitter(sketch, hash, description, countMinEstimate(sketches, sketch, hash));
+}
+
+/*
+This function estimates the number of distinct descriptions of a certain type from the
+HyperLogLog registers, using linear counting while many registers are still empty.
+*/
+double estimateDistinctDescriptions(const DescriptionSketches *sketches, ComplianceType type)
+{
+    const TypeSketch *sketch = &sketches->types[type];
+    int numRegisters = 1 << sketches->hllPrecision;
+    double sum = 0.0;
+    int numZeros = 0;
+    for (int i = 0; i < numRegisters; i++)
+    {
+        sum += 1.0 / (double)(1ULL << sketch->registers[i]);
+        numZeros += sketch->registers[i] == 0;
+    }
+    double alpha = numRegisters == 16 ? 0.673 : numRegisters == 32 ? 0.697 : numRegisters == 64 ? 0.709 : 0.7213 / (1.0 + 1.079 / numRegisters);
+    double estimate = alpha * numRegisters * numRegisters / sum;
+    if (estimate <= 2.5 * numRegisters && numZeros > 0)
+    {
+        estimate = numRegisters * log((double)numRegisters / numZeros);
+    }
+    return estimate;
+}
+
+/*
+This function estimates how often a description of a certain type was added. The estimate is
+never lower than the true count.
+*/
+unsigned int estimateDescriptionCount(const DescriptionSketches *sketches, ComplianceType type, const char *description)
+{
+    return countMinEstimate(sketches, &sketches->types[type], hashIncidentDescription(description));
+}
+
+/*
+This function copies the heavy hitters of a certain type, most frequent first, into the given
+array and returns how many were copied.
+*/
+int topDescriptions(const DescriptionSketches *sketches, ComplianceType type, HeavyHitter *heavyHitters, int maxHeavyHitters)
+{
+    const TypeSketch *sketch = &sketches->types[type];
+    HeavyHitter sorted[SKETCH_TOP_K];
+    memcpy(sorted, sketch->topK, sketch->numTopK * sizeof(HeavyHitter));
+    sortHeavyHitters(sorted, sketch->numTopK);
+    int count = sketch->numTopK < maxHeavyHitters ? sketch->numTopK : maxHeavyHitters;
+    memcpy(heavyHitters, sorted, count * sizeof(HeavyHitter));
+    return count;
+}
+
+/*
+This function merges other description sketches into the given ones, as if every description
+added to other had been added to them as well. HyperLogLog registers are merged by taking the
+maximum and Count-Min counters by adding. The heavy hitters of both sides are re-estimated from
+the merged counters and the most frequent ones are kept. The function returns 0 on success and
+-1 if the two sketches were built with different error bounds.
+*/
+int mergeDescriptionSketches(DescriptionSketches *sketches, const DescriptionSketches *other)
+{
+    if (sketches->hllPrecision != other->hllPrecision || sketches->countMinWidth != other->countMinWidth ||
+        sketches->countMinDepth != other->countMinDepth)
+    {
+        return -1;
+    }
+    for (int type = 0; type < 4; type++)
+    {
+        TypeSketch *sketch = &sketches->types[type];
+        const TypeSketch *otherSketch = &other->types[type];
+        for (int i = 0; i < (1 << sketches->hllPrecision); i++)
+        {
+            if (otherSketch->registers[i] > sketch->registers[i])
+            {
+                sketch->registers[i] = otherSketch->registers[i];
+            }
+        }
+        for (int row = 0; row < sketches->countMinDepth; row++)
+        {
+            for (int column = 0; column < sketches->countMinWidth; column++)
+            {
+                sketch->counts[row][column] += otherSketch->counts[row][column];
+            }
+        }
+
+        // Collect the heavy hitters of both sides without duplicates and re-estimate them
+        HeavyHitter candidates[2 * SKETCH_TOP_K];
+        int numCandidates = sketch->numTopK;
+        memcpy(candidates, sketch->topK, sketch->numTopK * sizeof(HeavyHitter));
+        for (int i = 0; i < otherSketch->numTopK; i++)
+        {
+            int duplicate = 0;
+            for (int j = 0; j < sketch->numTopK && !duplicate; j++)
+            {
+                duplicate = candidates[j].hash == otherSketch->topK[i].hash &&
+                            strcmp(candidates[j].description, otherSketch->topK[i].description) == 0;
+            }
+            if (!duplicate)
+            {
+                candidates[numCandidates++] = otherSketch->topK[i];
+            }
+        }
+        for (int i = 0; i < numCandidates; i++)
+        {
+            candidates[i].count = countMinEstimate(sketches, sketch, candidates[i].hash);
+        }
+
+        // Keep the most frequent candidates and rebuild the min-heap from them
+        sortHeavyHitters(candidates, numCandidates);
+        sketch->numTopK = 0;
+        for (int i = 0; i < numCandidates && i < SKETCH_TOP_K; i++)
+        {
+            sketch->topK[sketch->numTopK++] = candidates[i];
+            siftHeavyHitterUp(sketch, sketch->numTopK - 1);
+        }
+    }
+    return 0;
+}
+
+/*
+This function calculates the number of bytes serializeDescriptionSketches needs for the given
+sketches.
+*/
+int descriptionSketchesSerializedSize(const DescriptionSketches *sketches)
+{
+    int size = 16;
+    for (int type = 0; type < 4; type++)
+    {
+        size += (1 << sketches->hllPrecision) + 4 * sketches->countMinWidth * sketches->countMinDepth + 4;
+        for (int i = 0; i < sketches->types[type].numTopK; i++)
+        {
+            size += 8 + 4 + 1 + (int)strlen(sketches->types[type].topK[i].description);
+        }
+    }
+    return size;
+}
+
+/*
+This function serializes description sketches into a buffer in a portable little-endian
+format, so sketches built by different stores or processes can be merged. Only the registers
+and counters in use are written. It returns the number of bytes written, or -1 if the buffer
+is too small.
+*/
+int serializeDescriptionSketches(const DescriptionSketches *sketches, unsigned char *buffer, int size)
+{
+    if (size < descriptionSketchesSerializedSize(sketches))
+    {
+        return -1;
+    }
+    unsigned char *position = buffer;
+    writeSketchInteger(&position, SKETCH_MAGIC, 4);
+    writeSketchInteger(&position, sketches->hllPrecision, 4);
+    writeSketchInteger(&position, sketches->countMinWidth, 4);
+    writeSketchInteger(&position, sketches->countMinDepth, 4);
+    for (int type = 0; type < 4; type++)
+    {
+        const TypeSketch *sketch = &sketches->types[type];
+        memcpy(position, sketch->registers, 1 << sketches->hllPrecision);
+        position += 1 << sketches->hllPrecision;
+        for (int row = 0; row < sketches->countMinDepth; row++)
+        {
+            for (int column = 0; column < sketches->countMinWidth; column++)
+            {
+                writeSketchInteger(&position, sketch->counts[row][column], 4);
+            }
+        }
+        writeSketchInteger(&position, sketch->numTopK, 4);
+        for (int i = 0; i < sketch->numTopK; i++)
+        {
+            int length = (int)strlen(sketch->topK[i].description);
+            writeSketchInteger(&position, sketch->topK[i].hash, 8);
+            writeSketchInteger(&position, sketch->topK[i].count, 4);
+            writeSketchInteger(&position, length, 1);
+            memcpy(position, sketch->topK[i].description, length);
+            position += length;
+        }
+    }
+    return (int)(position - buffer);
+}
+
+/*
+This function restores description sketches from a buffer written by
+serializeDescriptionSketches. The restored sketches are not attached to any management system.
+It returns 0 on success and -1 if the buffer is truncated or does not hold valid sketches.
+*/
+int deserializeDescriptionSketches(DescriptionSketches *sketches, const unsigned char *buffer, int size)
+{
+    const unsigned char *position = buffer;
+    const unsigned char *end = buffer + size;
+    if (size < 16 || readSketchInteger(&position, 4) != SKETCH_MAGIC)
+    {
+        return -1;
+    }
+    int hllPrecision = (int)readSketchInteger(&position, 4);
+    int countMinWidth = (int)readSketchInteger(&position, 4);
+    int countMinDepth = (int)readSketchInteger(&position, 4);
+    if (initDescriptionSketches(sketches, hllPrecision, countMinWidth, countMinDepth) != 0)
+    {
+        return -1;
+    }
+    for (int type = 0; type < 4; type++)
+    {
+        TypeSketch *sketch = &sketches->types[type];
+        if (end - position < (1 << hllPrecision) + 4 * countMinWidth * countMinDepth + 4)
+        {
+            return -1;
+        }
+        memcpy(sketch->registers, position, 1 << hllPrecision);
+        position += 1 << hllPrecision;
+        for (int row = 0; row < countMinDepth; row++)
+        {
+            for (int column = 0; column < countMinWidth; column++)
+            {
+                sketch->counts[row][column] = (unsigned int)readSketchInteger(&position, 4);
+            }
+        }
+        int numTopK = (int)readSketchInteger(&position, 4);
+        if (numTopK < 0 || numTopK > SKETCH_TOP_K)
+        {
+            return -1;
+        }
+        for (int i = 0; i < numTopK; i++)
+        {
+            if (end - position < 13)
+            {
+                return -1;
+            }
+            sketch->topK[i].hash = readSketchInteger(&position, 8);
+            sketch->topK[i].count = (unsigned int)readSketchInteger(&position, 4);
+            int length = (int)readSketchInteger(&position, 1);
+            if (length > 99 || end - position < length)
+            {
+                return -1;
+            }
+            memcpy(sketch->topK[i].description, position, length);
+            sketch->topK[i].description[length] = '\0';
+            position += length;
+        }
+        sketch->numTopK = numTopK;
+    }
+    return 0;
+}
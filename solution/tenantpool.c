@@ -0,0 +1,317 @@
+#include "tenantpool.h"
+
+/*
+This helper is the mutation listener of a tenant store. It moves the incident that was added,
+updated, removed or tombstoned in the tenant aggregate, so the aggregate stays current however
+the system of the tenant is changed.
+*/
+static void recordTenantMutation(void *context, const ComplianceMutation *mutation)
+{
+    TenantAggregate *aggregate = &((TenantStore *)context)->aggregate;
+    const ComplianceIncident *incident = mutation->incident;
+    switch (mutation->kind)
+    {
+    case INCIDENT_ADDED:
+        aggregate->severityCounts[incident->type][incident->severity]++;
+        aggregate->totalSeverity += incident->severity;
+        aggregate->numIncidents++;
+        break;
+    case INCIDENT_SEVERITY_UPDATED:
+        aggregate->severityCounts[incident->type][mutation->oldSeverity]--;
+        aggregate->severityCounts[incident->type][incident->severity]++;
+        aggregate->totalSeverity += incident->severity - mutation->oldSeverity;
+        break;
+    case INCIDENT_REMOVED:
+    case INCIDENT_TOMBSTONED:
+        aggregate->severityCounts[incident->type][mutation->oldSeverity]--;
+        aggregate->totalSeverity -= mutation->oldSeverity;
+        aggregate->numIncidents--;
+        break;
+    case INCIDENT_COMPACTED:
+        break;
+    }
+}
+
+/*
+This helper takes a system for a tenant store that holds no system yet and starts following its
+mutations. The system is popped from the free list of the pool, which grows by one system slab
+when it is empty. It returns 0 on success and -1 if the memory could not be allocated or the
+listener could not be registered.
+*/
+static int takeTenantSystem(TenantStore *store)
+{
+    TenantPool *pool = store->pool;
+    if (pool->freeSystems == NULL)
+    {
+        TenantSystemSlab *slab = (TenantSystemSlab *)malloc(sizeof(TenantSystemSlab));
+        if (slab == NULL)
+        {
+            return -1;
+        }
+        slab->next = pool->systemSlabs;
+        pool->systemSlabs = slab;
+        pool->numSystemSlabs++;
+        for (int i = TENANT_SYSTEM_SLAB_SIZE - 1; i >= 0; i--)
+        {
+            slab->slots[i].nextFree = pool->freeSystems;
+            pool->freeSystems = &slab->slots[i];
+        }
+    }
+    TenantSystemSlot *slot = pool->freeSystems;
+    slot->system.numIncidents = 0;
+    if (addComplianceMutationListener(&slot->system, recordTenantMutation, store) != 0)
+    {
+        return -1;
+    }
+    pool->freeSystems = slot->nextFree;
+    slot->nextFree = NULL;
+    store->system = &slot->system;
+    return 0;
+}
+
+/*
+This helper gives the system of a tenant store, if it has one, back to the free list of the
+pool once the tenant goes away. The system memory stays in its slab until the pool is destroyed.
+*/
+static void releaseTenantSystem(TenantStore *store)
+{
+    if (store->system == NULL)
+    {
+        return;
+    }
+    removeComplianceMutationListener(store->system, recordTenantMutation, store);
+    TenantSystemSlot *slot = (TenantSystemSlot *)store->system;
+    slot->nextFree = store->pool->freeSystems;
+    store->pool->freeSystems = slot;
+    store->system = NULL;
+    memset(&store->aggregate, 0, sizeof(TenantAggregate));
+}
+
+/*
+This function initializes an empty tenant pool. No memory is allocated until the
+first tenant store is created.
+*/
+void initTenantPool(TenantPool *pool)
+{
+    pool->slabs = NULL;
+    pool->freeList = NULL;
+    pool->numSlabs = 0;
+    pool->numTenants = 0;
+    pool->systemSlabs = NULL;
+    pool->freeSystems = NULL;
+    pool->numSystemSlabs = 0;
+}
+
+/*
+This function releases every slab owned by a tenant pool, together with the systems of the
+tenants still in use. All tenant stores created from the pool and their systems become invalid,
+and the pool is left empty so it can be reused.
+*/
+void destroyTenantPool(TenantPool *pool)
+{
+    TenantSlab *slab = pool->slabs;
+    while (slab != NULL)
+    {
+        TenantSlab *next = slab->next;
+        for (int i = 0; i < TENANT_SLAB_SIZE; i++)
+        {
+            if (slab->stores[i].tenantId != -1)
+            {
+                releaseTenantSystem(&slab->stores[i]);
+            }
+        }
+        free(slab);
+        slab = next;
+    }
+    TenantSystemSlab *systemSlab = pool->systemSlabs;
+    while (systemSlab != NULL)
+    {
+        TenantSystemSlab *next = systemSlab->next;
+        free(systemSlab);
+        systemSlab = next;
+    }
+    initTenantPool(pool);
+}
+
+/*
+This function creates an empty tenant store from the pool. If the free list is empty,
+the pool allocates one more slab and threads its stores onto the free list, so memory
+grows with the number of tenants actually in use. The store is popped from the free list,
+cleared and tagged with the given tenant id. Its system is only taken from the pool once the
+first incident is added. The function returns NULL if a new slab could not be allocated.
+*/
+TenantStore *createTenantStore(TenantPool *pool, int tenantId)
+{
+    // Grow the pool by one slab if there are no free stores left
+    if (pool->freeList == NULL)
+    {
+        TenantSlab *slab = (TenantSlab *)malloc(sizeof(TenantSlab));
+        if (slab == NULL)
+        {
+            return NULL;
+        }
+        slab->next = pool->slabs;
+        pool->slabs = slab;
+        pool->numSlabs++;
+        for (int i = TENANT_SLAB_SIZE - 1; i >= 0; i--)
+        {
+            slab->stores[i].tenantId = -1;
+            slab->stores[i].nextFree = pool->freeList;
+            pool->freeList = &slab->stores[i];
+        }
+    }
+
+    // Pop a store from the free list and reset it
+    TenantStore *store = pool->freeList;
+    pool->freeList = store->nextFree;
+    store->system = NULL;
+    memset(&store->aggregate, 0, sizeof(TenantAggregate));
+    store->tenantId = tenantId;
+    store->nextFree = NULL;
+    store->pool = pool;
+    pool->numTenants++;
+    return store;
+}
+
+/*
+This function returns a tenant store to the pool by giving its system back to the pool and
+pushing the store onto the free list. The slab memory is kept so the next tenant can be created,
+and can hold incidents, without allocating. A pointer to the system of the store must not be
+used after this call, since the system can be handed to another tenant.
+*/
+void destroyTenantStore(TenantPool *pool, TenantStore *store)
+{
+    if (store == NULL || store->tenantId == -1)
+    {
+        return;
+    }
+    releaseTenantSystem(store);
+    store->tenantId = -1;
+    store->nextFree = pool->freeList;
+    pool->freeList = store;
+    pool->numTenants--;
+}
+
+/*
+This function adds a compliance incident to a tenant store. The tenant takes a system from the
+pool first if it holds none yet, and keeps it from then on, even once its incidents are removed,
+so a tenant moving between zero and one incident does not allocate or register listeners. The
+tenant aggregate is updated by the mutation listener of the store.
+*/
+void addTenantIncident(TenantStore *store, ComplianceIncident incident)
+{
+    if (store->system == NULL && takeTenantSystem(store) != 0)
+    {
+        return;
+    }
+    addComplianceIncident(store->system, incident);
+}
+
+/*
+This function updates the severity of a compliance incident in a tenant store with
+updateComplianceIncidentSeverity and returns its result. A tenant without a system returns
+-1, as for an incident that is not found.
+*/
+int updateTenantIncidentSeverity(TenantStore *store, ComplianceIncident incident, int newSeverity)
+{
+    if (store->system == NULL)
+    {
+        return -1;
+    }
+    return updateComplianceIncidentSeverity(store->system, incident, newSeverity);
+}
+
+/*
+This function removes all compliance incidents of a certain type from a tenant store
+and returns the number of incidents removed. The tenant keeps its system if it is left empty.
+*/
+int removeTenantIncidentsOfType(TenantStore *store, ComplianceType type)
+{
+    if (store->system == NULL)
+    {
+        return 0;
+    }
+    return removeComplianceIncidentsOfType(store->system, type);
+}
+
+/*
+This function removes a compliance incident from a tenant store. The tenant keeps its system
+if it is left empty.
+*/
+void removeTenantIncident(TenantStore *store, ComplianceIncident incident)
+{
+    if (store->system == NULL)
+    {
+        return;
+    }
+    removeComplianceIncident(store->system, incident);
+}
+
+/*
+This function merges the aggregates of a set of tenant stores into a single aggregate.
+It only adds up the per-tenant counters, so the cost depends on the number of tenants
+and not on the number of incidents they hold.
+*/
+void rollupTenantAggregates(TenantStore **stores, int numStores, TenantAggregate *result)
+{
+    memset(result, 0, sizeof(TenantAggregate));
+    for (int i = 0; i < numStores; i++)
+    {
+        const TenantAggregate *aggregate = &stores[i]->aggregate;
+        for (int type = 0; type < 4; type++)
+        {
+            for (int severity = 1; severity <= 10; severity++)
+            {
+                result->severityCounts[type][severity] += aggregate->severityCounts[type][severity];
+            }
+        }
+        result->numIncidents += aggregate->numIncidents;
+        result->totalSeverity += aggregate->totalSeverity;
+    }
+}
+
+/*
+This function calculates the average severity recorded in an aggregate. It returns 0
+if the aggregate holds no incidents.
+*/
+float aggregateAverageSeverity(const TenantAggregate *aggregate)
+{
+    if (aggregate->numIncidents == 0)
+    {
+        return 0.0;
+    }
+    return (float)aggregate->totalSeverity / aggregate->numIncidents;
+}
+
+/*
+This function finds the highest severity recorded in an aggregate by walking the
+severity counts from 10 down to 1. It returns 0 if the aggregate holds no incidents.
+*/
+int aggregateHighestSeverity(const TenantAggregate *aggregate)
+{
+    for (int severity = 10; severity >= 1; severity--)
+    {
+        for (int type = 0; type < 4; type++)
+        {
+            if (aggregate->severityCounts[type][severity] > 0)
+            {
+                return severity;
+            }
+        }
+    }
+    return 0;
+}
+
+/*
+This function counts the incidents of a certain type recorded in an aggregate by adding
+up the severity counts of that type.
+*/
+int aggregateCountOfType(const TenantAggregate *aggregate, ComplianceType type)
+{
+    int count = 0;
+    for (int severity = 1; severity <= 10; severity++)
+    {
+        count += aggregate->severityCounts[type][severity];
+    }
+    return count;
+}
@@ -0,0 +1,371 @@
+#include <time.h>
+#include "tombstone.h"
+
+/*
+This helper checks whether the incident at a position is tombstoned.
+*/
+static int isPositionTombstoned(const TombstoneStore *store, int index)
+{
+    return (int)((store->tombstones.words[index / 64] >> (index % 64)) & 1);
+}
+
+/*
+This helper is the mutation listener of a tombstone store. A tombstone sets the bit of its
+position. Whenever an incident is physically removed, by compaction or by any other removal
+function, its bit is dropped and the bits of the incidents after it move down by one position
+along with the incidents.
+*/
+static void recordTombstoneMutation(void *context, const ComplianceMutation *mutation)
+{
+    TombstoneStore *store = (TombstoneStore *)context;
+    switch (mutation->kind)
+    {
+    case INCIDENT_TOMBSTONED:
+        bitmapSetPosition(&store->tombstones, mutation->index);
+        store->numTombstones++;
+        break;
+    case INCIDENT_REMOVED:
+    case INCIDENT_COMPACTED:
+        if (isPositionTombstoned(store, mutation->index))
+        {
+            store->numTombstones--;
+        }
+        bitmapRemovePosition(&store->tombstones, mutation->index);
+        break;
+    case INCIDENT_ADDED:
+    case INCIDENT_SEVERITY_UPDATED:
+        break;
+    }
+}
+
+/*
+This helper reclaims up to budget tombstones, the ones at the highest positions, so that fewer
+incidents have to move. The chosen tombstones are removed together with removeComplianceIncidentsAt,
+which moves every incident after them once and only tells the listeners about the shifts since the
+incidents were already removed logically. The caller must hold the store lock. It returns the
+number of tombstones reclaimed.
+*/
+static int compactTombstonesLocked(TombstoneStore *store, int budget)
+{
+    int numChosen = 0;
+    IncidentBitmap chosen;
+    memset(&chosen, 0, sizeof(IncidentBitmap));
+    for (int w = INCIDENT_BITMAP_WORDS - 1; w >= 0 && numChosen < budget; w--)
+    {
+        unsigned long long word = store->tombstones.words[w];
+        while (word != 0 && numChosen < budget)
+        {
+            int bit = 63 - __builtin_clzll(word);
+            word &= ~(1ULL << bit);
+            chosen.words[w] |= 1ULL << bit;
+            numChosen++;
+        }
+    }
+    return removeComplianceIncidentsAt(store->system, chosen);
+}
+
+/*
+This helper checks whether the share of tombstoned incidents has reached the compaction threshold.
+*/
+static int needsCompaction(const TombstoneStore *store)
+{
+    return store->numTombstones > 0 && store->numTombstones >= store->compactionThreshold * store->system->numIncidents;
+}
+
+/*
+This helper runs one compaction step piggybacked on a write, unless a background compactor is
+taking care of it. The caller must hold the store lock.
+*/
+static void compactAfterWrite(TombstoneStore *store)
+{
+    if (!store->compactorRunning && needsCompaction(store))
+    {
+        compactTombstonesLocked(store, store->compactionBudget);
+    }
+}
+
+/*
+This helper is the loop of the background compactor thread. It wakes up at the configured
+interval and runs one compaction step whenever the threshold has been reached.
+*/
+static void *runTombstoneCompactor(void *argument)
+{
+    TombstoneStore *store = (TombstoneStore *)argument;
+    struct timespec interval;
+    interval.tv_sec = store->compactorIntervalMilliseconds / 1000;
+    interval.tv_nsec = (long)(store->compactorIntervalMilliseconds % 1000) * 1000000L;
+    for (;;)
+    {
+        pthread_mutex_lock(&store->lock);
+        if (!store->compactorRunning)
+        {
+            pthread_mutex_unlock(&store->lock);
+            return NULL;
+        }
+        if (needsCompaction(store))
+        {
+            compactTombstonesLocked(store, store->compactionBudget);
+        }
+        pthread_mutex_unlock(&store->lock);
+        nanosleep(&interval, NULL);
+    }
+}
+
+/*
+This function starts deferring the removals of a management system as tombstones. Incidents
+the system already holds as tombstones are picked up. Compaction starts once compactionThreshold
+of the incidents are tombstoned, for example 0.25 for a quarter, and reclaims at most
+compactionBudget tombstones per step. It returns 0 on success and -1 if no more listeners can
+be registered.
+*/
+int attachTombstoneStore(TombstoneStore *store, ComplianceManagementSystem *system, float compactionThreshold, int compactionBudget)
+{
+    memset(&store->tombstones, 0, sizeof(IncidentBitmap));
+    store->system = system;
+    store->numTombstones = 0;
+    store->compactionThreshold = compactionThreshold;
+    store->compactionBudget = compactionBudget > 0 ? compactionBudget : 1;
+    store->compactorRunning = 0;
+    store->compactorIntervalMilliseconds = 0;
+    for (int i = 0; i < system->numIncidents; i++)
+    {
+        if (isComplianceIncidentTombstoned(&system->incidents[i].dataPrivacyIncident))
+        {
+            bitmapSetPosition(&store->tombstones, i);
+            store->numTombstones++;
+        }
+    }
+    if (addComplianceMutationListener(system, recordTombstoneMutation, store) != 0)
+    {
+        return -1;
+    }
+    pthread_mutex_init(&store->lock, NULL);
+    return 0;
+}
+
+/*
+This function stops deferring removals. The background compactor is stopped if it is running,
+every remaining tombstone is compacted so the system only holds live incidents, and the store
+stops listening to the system.
+*/
+void detachTombstoneStore(TombstoneStore *store)
+{
+    stopTombstoneCompactor(store);
+    pthread_mutex_lock(&store->lock);
+    compactTombstonesLocked(store, store->numTombstones);
+    pthread_mutex_unlock(&store->lock);
+    removeComplianceMutationListener(store->system, recordTombstoneMutation, store);
+    pthread_mutex_destroy(&store->lock);
+}
+
+/*
+This function adds a compliance incident through a tombstone store. If the system is full and
+holds tombstones, a compaction step makes room first. The incident is then added with
+addComplianceIncident, and a compaction step is piggybacked on the write if the threshold has
+been reached and no background compactor is running.
+*/
+void addLiveIncident(TombstoneStore *store, ComplianceIncident incident)
+{
+    pthread_mutex_lock(&store->lock);
+    if (store->system->numIncidents == 100 && store->numTombstones > 0)
+    {
+        compactTombstonesLocked(store, store->compactionBudget);
+    }
+    addComplianceIncident(store->system, incident);
+    compactAfterWrite(store);
+    pthread_mutex_unlock(&store->lock);
+}
+
+/*
+This function marks the compliance incident at a given position as removed with
+tombstoneComplianceIncidentAt, without moving any incident. From then on every function and
+listener of the system treats it as removed. Since a background compactor moves incidents
+between calls, a position read by the caller may no longer name the same incident, so the call
+is rejected while the compactor runs; tombstoneIncident finds the incident under the lock
+instead. It returns 0 on success and -1 if the position is out of range or already tombstoned,
+or if the compactor is running.
+*/
+int tombstoneIncidentAt(TombstoneStore *store, int index)
+{
+    pthread_mutex_lock(&store->lock);
+    if (store->compactorRunning)
+    {
+        pthread_mutex_unlock(&store->lock);
+        return -1;
+    }
+    int result = tombstoneComplianceIncidentAt(store->system, index);
+    if (result == 0)
+    {
+        compactAfterWrite(store);
+    }
+    pthread_mutex_unlock(&store->lock);
+    return result;
+}
+
+/*
+This function marks the first live incident equal to the given one as removed, matching the
+same way removeComplianceIncident does. It returns 0 on success and -1 if no live incident
+matches.
+*/
+int tombstoneIncident(TombstoneStore *store, ComplianceIncident incident)
+{
+    pthread_mutex_lock(&store->lock);
+    int incidentIndex = -1;
+    for (int i = 0; i < store->system->numIncidents; i++)
+    {
+        if (memcmp(&store->system->incidents[i], &incident, sizeof(ComplianceIncident)) == 0)
+        {
+            incidentIndex = i;
+            break;
+        }
+    }
+    if (incidentIndex == -1)
+    {
+        pthread_mutex_unlock(&store->lock);
+        return -1;
+    }
+    tombstoneComplianceIncidentAt(store->system, incidentIndex);
+    compactAfterWrite(store);
+    pthread_mutex_unlock(&store->lock);
+    return 0;
+}
+
+/*
+This function marks all live compliance incidents of a certain type as removed and returns the
+number of incidents marked.
+*/
+int tombstoneIncidentsOfType(TombstoneStore *store, ComplianceType type)
+{
+    pthread_mutex_lock(&store->lock);
+    int numRemoved = 0;
+    for (int i = 0; i < store->system->numIncidents; i++)
+    {
+        if (store->system->incidents[i].dataPrivacyIncident.type == type && tombstoneComplianceIncidentAt(store->system, i) == 0)
+        {
+            numRemoved++;
+        }
+    }
+    compactAfterWrite(store);
+    pthread_mutex_unlock(&store->lock);
+    return numRemoved;
+}
+
+/*
+This function checks whether the incident at a given position is marked as removed. While a
+background compactor runs, the answer is only about whichever incident holds the position at
+the time of the call. It returns 1 if it is, and 0 if it is live or the position is out of range.
+*/
+int isIncidentTombstoned(TombstoneStore *store, int index)
+{
+    pthread_mutex_lock(&store->lock);
+    int tombstoned = index >= 0 && index < store->system->numIncidents && isPositionTombstoned(store, index);
+    pthread_mutex_unlock(&store->lock);
+    return tombstoned;
+}
+
+/*
+This function counts the incidents that are not marked as removed.
+*/
+int countLiveIncidents(TombstoneStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    int count = store->system->numIncidents - store->numTombstones;
+    pthread_mutex_unlock(&store->lock);
+    return count;
+}
+
+/*
+This function counts the incidents the system holds, including the ones marked as removed but
+not yet compacted. It reads the count under the store lock, so it is safe to call while the
+background compactor runs.
+*/
+int countStoredIncidents(TombstoneStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    int count = store->system->numIncidents;
+    pthread_mutex_unlock(&store->lock);
+    return count;
+}
+
+/*
+This function calculates the average severity of the incidents that are not marked as removed
+with calculateAverageSeverity, which skips tombstoned incidents, while holding the store lock.
+It returns 0 if there are no live incidents.
+*/
+float calculateLiveAverageSeverity(TombstoneStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    float averageSeverity = calculateAverageSeverity(*store->system);
+    pthread_mutex_unlock(&store->lock);
+    return averageSeverity;
+}
+
+/*
+This function finds the live incident with the highest severity with findHighestSeverityIncident,
+which skips tombstoned incidents, while holding the store lock. If there are no live incidents,
+it returns the same empty incident as findHighestSeverityIncident.
+*/
+ComplianceIncident findHighestLiveSeverityIncident(TombstoneStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    ComplianceIncident highestSeverityIncident = findHighestSeverityIncident(*store->system);
+    pthread_mutex_unlock(&store->lock);
+    return highestSeverityIncident;
+}
+
+/*
+This function runs one compaction step by hand, reclaiming up to budget tombstones regardless of
+the threshold. It returns the number of tombstones reclaimed.
+*/
+int compactTombstones(TombstoneStore *store, int budget)
+{
+    pthread_mutex_lock(&store->lock);
+    int numReclaimed = compactTombstonesLocked(store, budget);
+    pthread_mutex_unlock(&store->lock);
+    return numReclaimed;
+}
+
+/*
+This function starts a background thread that runs a compaction step every intervalMilliseconds
+once the threshold has been reached. Writes stop piggybacking compaction while it runs. While the
+compactor runs, the system must only be changed through the tombstone store, and the system and
+every structure attached to it as a mutation listener must only be read while holding the store
+lock, since compaction changes them on the compactor thread. Positions are not stable between
+calls, so tombstoneIncidentAt is rejected. It returns 0 on success and -1 if the compactor is
+already running or the thread could not be started.
+*/
+int startTombstoneCompactor(TombstoneStore *store, int intervalMilliseconds)
+{
+    pthread_mutex_lock(&store->lock);
+    if (store->compactorRunning)
+    {
+        pthread_mutex_unlock(&store->lock);
+        return -1;
+    }
+    store->compactorRunning = 1;
+    store->compactorIntervalMilliseconds = intervalMilliseconds > 0 ? intervalMilliseconds : 1;
+    if (pthread_create(&store->compactor, NULL, runTombstoneCompactor, store) != 0)
+    {
+        store->compactorRunning = 0;
+        pthread_mutex_unlock(&store->lock);
+        return -1;
+    }
+    pthread_mutex_unlock(&store->lock);
+    return 0;
+}
+
+/*
+This function stops the background compactor and waits for its thread to finish. Writes
+piggyback compaction steps again afterwards.
+*/
+void stopTombstoneCompactor(TombstoneStore *store)
+{
+    pthread_mutex_lock(&store->lock);
+    int running = store->compactorRunning;
+    store->compactorRunning = 0;
+    pthread_mutex_unlock(&store->lock);
+    if (running)
+    {
+        pthread_join(store->compactor, NULL);
+    }
+}
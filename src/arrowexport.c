@@ -0,0 +1,16 @@
+#include <stdlib.h>
+#include "arrowexport.h"
+
+/*
+This function exports the incidents of a management system through the Arrow C Data Interface,
+as a struct array with an int32 "type" column, an int32 "severity" column and a utf8
+"description" column, none of which has nulls. Arrow columns must be contiguous, while the
+system stores whole incidents one after the other, so the columns are gathered in one pass into
+a single block. That block is freed once the array and every column moved out of it have been
+released, so the export stays valid after the system changes and can be handed to any Arrow
+consumer without a library dependency. Tombstoned incidents are left out of the export. It returns 0 on success and -1 if the memory could not
+be allocated, in which case neither struct is touched.
+*/
+int exportIncidentsToArrow(const ComplianceManagementSystem *system, struct ArrowSchema *schema, struct ArrowArray *array)
+{
+}
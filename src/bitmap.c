@@ -18,6 +18,7 @@ average severity of all incidents in the system. It first checks if there are an
 incidents in the system and returns 0 if there are none. Then, it loops through 
 all incidents in the system and adds up the severity of each one based on its type. 
 Finally, it calculates the average severity and returns it as a float value.
+Tombstoned incidents are skipped and do not count towards the average.
 */
 float calculateAverageSeverity(ComplianceManagementSystem system)
 {
@@ -28,7 +29,8 @@ This function removes all incidents of a given type from a Compliance Management
 It loops through all incidents in the system, checks if the incident matches the type to be removed, 
 shifts all incidents after this one back by one position, decrements the number of incidents in the system, 
 and increments the number of removed incidents. Finally, it zeros out the remaining incidents that were 
-shifted back and returns the number of incidents that were removed.
+shifted back and returns the number of incidents that were removed. Tombstoned incidents are already
+removed and are left for compaction.
 */
 int removeComplianceIncidentsOfType(ComplianceManagementSystem *system, ComplianceType type)
 {
@@ -40,7 +42,7 @@ and returns the incident with the highest severity. If there are no incidents, t
 default empty incident with a data privacy type and a message stating "No incidents in the system." 
 The function loops through all incidents in the system and compares their severity with the current highest severity incident, 
 updating it if a higher severity incident is found. The function returns the highest severity incident found.
-
+Tombstoned incidents are skipped, so a system holding only tombstoned incidents also returns the empty incident.
 */
 ComplianceIncident findHighestSeverityIncident(ComplianceManagementSystem system)
 {
@@ -52,7 +54,7 @@ It takes three parameters: a pointer to the compliance management system, the co
 and the new severity value. The function searches for the incident in the system, and if found, checks if the 
 new severity value is within the allowed range of 1-10. If the new severity is within the range, it updates 
 the incident's severity and returns 0 to indicate success. If the new severity is out of range, it returns 1. 
-If the incident is not found in the system, it returns -1.
+If the incident is not found in the system, it returns -1. Tombstoned incidents are never updated.
 */
 int updateComplianceIncidentSeverity(ComplianceManagementSystem *system, ComplianceIncident incident, int newSeverity)
 {
@@ -67,3 +69,76 @@ the function returns without removing anything.
 void removeComplianceIncident(ComplianceManagementSystem *system, ComplianceIncident incident)
 {
 }
+
+/*
+This function removes the compliance incident at a given position of a management system,
+shifting all incidents after it back by one index and decrementing the number of incidents
+in the system. Removing a tombstoned incident compacts it: the listeners are told with
+INCIDENT_COMPACTED, since the incident was already removed logically. It returns 0 on success
+and -1 if the position is out of range.
+*/
+int removeComplianceIncidentAt(ComplianceManagementSystem *system, int index)
+{
+}
+
+/*
+This function removes the compliance incidents at a set of positions of a management system in
+one pass. The listeners are told about every removal first, from the highest position down, so
+each index is the one a removal at a time would report and every removed incident is still in
+place. Then each remaining incident after the lowest removed position is moved back once, so
+the cost is one pass over the system however many incidents are removed. Tombstoned incidents
+are compacted as with removeComplianceIncidentAt, and positions past the last incident are
+ignored. It returns the number of incidents removed.
+*/
+int removeComplianceIncidentsAt(ComplianceManagementSystem *system, IncidentBitmap positions)
+{
+}
+
+/*
+This function marks the compliance incident at a given position of a management system as
+removed without moving any incident, so positions held elsewhere stay valid until the incident
+is compacted with removeComplianceIncidentAt. The listeners are told with INCIDENT_TOMBSTONED
+before the severity of the incident is negated. It returns 0 on success and -1 if the position
+is out of range or the incident is already tombstoned.
+*/
+int tombstoneComplianceIncidentAt(ComplianceManagementSystem *system, int index)
+{
+}
+
+/*
+This function checks whether a compliance incident is tombstoned, that is whether its severity
+is negative. It returns 1 if it is and 0 otherwise.
+*/
+int isComplianceIncidentTombstoned(const ComplianceIncident *incident)
+{
+}
+
+/*
+This function registers a listener that is called for every incident added to, updated in
+or removed from the given management system. Each system has its own listeners, so any number
+of systems can have listeners at the same time, and the same listener can be registered for
+several systems. It returns 0 on success and -1 if the system already has
+MAX_MUTATION_LISTENERS listeners or the memory could not be allocated.
+*/
+int addComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context)
+{
+}
+
+/*
+This function unregisters a listener that was registered for the given management system
+with the same context. Listeners registered after it keep their relative order. If the
+listener is not registered, the function returns without changing anything.
+*/
+void removeComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context)
+{
+}
+
+/*
+This function hashes the description of a compliance incident with 64-bit FNV-1a, followed by
+a final mixing step so that descriptions differing only in their last characters still differ
+in the high bits. The hash is used wherever descriptions need to be identified compactly without
+keeping the text.
+*/
+unsigned long long hashIncidentDescription(const char *description)
+{
+}
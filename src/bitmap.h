@@ -1,3 +1,6 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
 #include <stdio.h>
 #include <string.h>
 
@@ -34,6 +37,60 @@ typedef struct
     int numIncidents;
 } ComplianceManagementSystem;
 
+// Define the number of 64-bit words needed for one bit per incident position
+#define INCIDENT_BITMAP_WORDS 2
+
+// Define struct for a set of incident positions, one bit per position
+typedef struct
+{
+    unsigned long long words[INCIDENT_BITMAP_WORDS];
+} IncidentBitmap;
+
+// Define the maximum number of mutation listeners that can be registered for one management system
+#define MAX_MUTATION_LISTENERS 16
+
+// Thread safety of mutations and listeners:
+// - A management system must not be changed from two threads at once, and must not be read while
+//   another thread changes it; callers that share a system between threads have to lock around it.
+// - Different systems can be changed from different threads at the same time. The mutation
+//   sequence is advanced atomically and the listener table is guarded by a read-write lock.
+// - Listeners can be registered and unregistered from any thread, but not from inside a listener.
+// - A listener runs on the thread that changed its system, before the changing function returns.
+
+// Tombstoned incidents:
+// - A tombstoned incident is logically removed but keeps its position until it is compacted, so the
+//   positions of the other incidents do not move. It keeps its type and description and stores its
+//   severity negated, which every function and scan treats as not being an incident at all.
+// - Tombstoning announces INCIDENT_TOMBSTONED, the logical removal. Removing the incident from its
+//   position later announces INCIDENT_COMPACTED, which only shifts the positions after it.
+// - numIncidents counts tombstoned incidents until they are compacted, so addComplianceIncident
+//   rejects a system that holds 100 incidents even when some are tombstoned. The core add path does
+//   not scan for them; addLiveIncident of a tombstone store compacts to make room, and other
+//   callers can compact with removeComplianceIncidentsAt first.
+
+// Define enum for the kinds of mutations applied to a management system
+typedef enum
+{
+    INCIDENT_ADDED,
+    INCIDENT_SEVERITY_UPDATED,
+    INCIDENT_REMOVED,
+    INCIDENT_TOMBSTONED,
+    INCIDENT_COMPACTED
+} ComplianceMutationKind;
+
+// Define struct describing a single mutation of a management system
+typedef struct
+{
+    ComplianceMutationKind kind;
+    unsigned long sequence;             // increases by one for every mutation applied to any system
+    int index;                          // position of the incident before the mutation shifts anything
+    const ComplianceIncident *incident; // incident as stored after an add or update, or before a removal or tombstone
+    int oldSeverity;                    // severity before the mutation, 0 for an add or a compaction
+} ComplianceMutation;
+
+// Define the callback type invoked for every mutation of a management system
+typedef void (*ComplianceMutationListener)(void *context, const ComplianceMutation *mutation);
+
 // Function to add a compliance incident to the management system
 void addComplianceIncident(ComplianceManagementSystem *system, ComplianceIncident incident);
 
@@ -52,3 +109,25 @@ int updateComplianceIncidentSeverity(ComplianceManagementSystem *system, Complia
 // Function to remove a compliance incident from the management system
 void removeComplianceIncident(ComplianceManagementSystem *system, ComplianceIncident incident);
 
+// Function to remove the compliance incident at a given position of the management system
+int removeComplianceIncidentAt(ComplianceManagementSystem *system, int index);
+
+// Function to remove the compliance incidents at a set of positions of the management system
+int removeComplianceIncidentsAt(ComplianceManagementSystem *system, IncidentBitmap positions);
+
+// Function to mark the compliance incident at a given position as removed without moving any incident
+int tombstoneComplianceIncidentAt(ComplianceManagementSystem *system, int index);
+
+// Function to check whether a compliance incident is tombstoned
+int isComplianceIncidentTombstoned(const ComplianceIncident *incident);
+
+// Function to register a listener for the mutations of a management system
+int addComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context);
+
+// Function to unregister a listener from the mutations of a management system
+void removeComplianceMutationListener(ComplianceManagementSystem *system, ComplianceMutationListener listener, void *context);
+
+// Function to hash the description of a compliance incident
+unsigned long long hashIncidentDescription(const char *description);
+
+#endif
@@ -0,0 +1,119 @@
+#include "bitmapindex.h"
+
+/*
+This function builds the type and severity bitmaps of a management system with one scan over
+its incidents, then registers them as a mutation listener so every add, severity update and
+removal keeps them up to date. Incidents with an invalid type or severity are left out. It
+returns 0 on success and -1 if no more listeners can be registered.
+*/
+int attachBitmapIndex(IncidentBitmapIndex *index, ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function stops keeping the bitmap indexes of a management system up to date.
+*/
+void detachBitmapIndex(IncidentBitmapIndex *index)
+{
+}
+
+/*
+This function returns the positions of the incidents of a certain type.
+*/
+IncidentBitmap indexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type)
+{
+}
+
+/*
+This function returns the positions of the incidents with a severity between minSeverity and
+maxSeverity, both included, by uniting the bitmaps of those severities.
+*/
+IncidentBitmap indexedIncidentsWithSeverity(const IncidentBitmapIndex *index, int minSeverity, int maxSeverity)
+{
+}
+
+/*
+This function returns the positions that are in both bitmaps.
+*/
+IncidentBitmap bitmapAnd(IncidentBitmap a, IncidentBitmap b)
+{
+}
+
+/*
+This function returns the positions that are in either bitmap.
+*/
+IncidentBitmap bitmapOr(IncidentBitmap a, IncidentBitmap b)
+{
+}
+
+/*
+This function returns the positions of the first bitmap that are not in the second one.
+*/
+IncidentBitmap bitmapAndNot(IncidentBitmap a, IncidentBitmap b)
+{
+}
+
+/*
+This function adds one incident position to a bitmap.
+*/
+void bitmapSetPosition(IncidentBitmap *bitmap, int position)
+{
+}
+
+/*
+This function takes one incident position out of a bitmap, leaving the other positions as they are.
+*/
+void bitmapClearPosition(IncidentBitmap *bitmap, int position)
+{
+}
+
+/*
+This function drops one position from a bitmap and moves every higher position down by one,
+mirroring how the removal functions shift the incidents after a removed one back by one index.
+*/
+void bitmapRemovePosition(IncidentBitmap *bitmap, int position)
+{
+}
+
+/*
+This function counts the positions in a bitmap.
+*/
+int bitmapCardinality(IncidentBitmap bitmap)
+{
+}
+
+/*
+This function finds the first position in a bitmap at or after a given one, so the positions
+can be walked with for (p = bitmapNextPosition(b, 0); p != -1; p = bitmapNextPosition(b, p + 1)).
+It returns -1 if there is no such position.
+*/
+int bitmapNextPosition(IncidentBitmap bitmap, int from)
+{
+}
+
+/*
+This function counts the incidents of a certain type by reading the cardinality of its bitmap,
+without looking at the incidents.
+*/
+int countIndexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type)
+{
+}
+
+/*
+This function removes the incidents at the positions of a bitmap from the indexed management
+system, for example a combination of type and severity bitmaps, with removeComplianceIncidentsAt.
+The system is compacted in one pass, and the indexes follow along through the mutation listener
+at a fixed cost per removed incident. It returns the number of incidents removed.
+*/
+int removeIndexedIncidents(IncidentBitmapIndex *index, IncidentBitmap bitmap)
+{
+}
+
+/*
+This function removes all incidents of a certain type from the indexed management system. Only
+the positions in the type bitmap are visited, so finding the incidents costs time proportional
+to the number removed rather than to the size of the system.
+*/
+int removeIndexedIncidentsOfType(IncidentBitmapIndex *index, ComplianceType type)
+{
+}
@@ -0,0 +1,59 @@
+#ifndef BITMAPINDEX_H
+#define BITMAPINDEX_H
+
+#include "bitmap.h"
+
+// Define struct for the bitmap indexes of a management system on type and severity
+typedef struct
+{
+    IncidentBitmap typeBitmaps[4];
+    IncidentBitmap severityBitmaps[11]; // index 0 unused
+    ComplianceManagementSystem *system;
+} IncidentBitmapIndex;
+
+// Function to build bitmap indexes for a management system and keep them up to date
+int attachBitmapIndex(IncidentBitmapIndex *index, ComplianceManagementSystem *system);
+
+// Function to stop keeping bitmap indexes up to date
+void detachBitmapIndex(IncidentBitmapIndex *index);
+
+// Function to get the positions of the incidents of a certain type
+IncidentBitmap indexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type);
+
+// Function to get the positions of the incidents with a severity in a range
+IncidentBitmap indexedIncidentsWithSeverity(const IncidentBitmapIndex *index, int minSeverity, int maxSeverity);
+
+// Function to intersect two incident bitmaps
+IncidentBitmap bitmapAnd(IncidentBitmap a, IncidentBitmap b);
+
+// Function to unite two incident bitmaps
+IncidentBitmap bitmapOr(IncidentBitmap a, IncidentBitmap b);
+
+// Function to remove the positions of one incident bitmap from another
+IncidentBitmap bitmapAndNot(IncidentBitmap a, IncidentBitmap b);
+
+// Function to add a position to an incident bitmap
+void bitmapSetPosition(IncidentBitmap *bitmap, int position);
+
+// Function to take a position out of an incident bitmap
+void bitmapClearPosition(IncidentBitmap *bitmap, int position);
+
+// Function to drop a position from an incident bitmap, moving higher positions down by one
+void bitmapRemovePosition(IncidentBitmap *bitmap, int position);
+
+// Function to count the positions in an incident bitmap
+int bitmapCardinality(IncidentBitmap bitmap);
+
+// Function to find the first position in an incident bitmap at or after a given one
+int bitmapNextPosition(IncidentBitmap bitmap, int from);
+
+// Function to count the incidents of a certain type using the bitmap indexes
+int countIndexedIncidentsOfType(const IncidentBitmapIndex *index, ComplianceType type);
+
+// Function to remove the incidents in an incident bitmap from the indexed management system
+int removeIndexedIncidents(IncidentBitmapIndex *index, IncidentBitmap bitmap);
+
+// Function to remove all incidents of a certain type using the bitmap indexes
+int removeIndexedIncidentsOfType(IncidentBitmapIndex *index, ComplianceType type);
+
+#endif
@@ -0,0 +1,48 @@
+#include "changefeed.h"
+
+/*
+This function attaches an empty change feed to a management system by registering it as
+a mutation listener. From then on every add, severity update and removal applied to the
+system is appended to the feed. It returns 0 on success and -1 if no more listeners can be
+registered.
+*/
+int attachChangeFeed(ChangeFeed *feed, ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function stops recording mutations into a change feed. Records already in the feed
+can still be read.
+*/
+void detachChangeFeed(ChangeFeed *feed)
+{
+}
+
+/*
+This function returns the oldest sequence that can still be read from a change feed. Cursors
+positioned before it have lagged behind the writer and lost records. The slot the writer fills
+next is not counted, so at most CHANGE_FEED_CAPACITY - 1 records can be read back.
+*/
+unsigned long oldestChangeFeedSequence(const ChangeFeed *feed)
+{
+}
+
+/*
+This function positions a cursor at a sequence of a change feed. A reader resumes from the
+sequence it last saw plus one, or starts from oldestChangeFeedSequence to replay everything
+still held.
+*/
+void seekChangeFeedCursor(ChangeFeedCursor *cursor, unsigned long sequence)
+{
+}
+
+/*
+This function copies up to maxRecords delta records starting at the cursor and advances
+the cursor past them. It returns the number of records copied, which is 0 when the reader
+has caught up with the writer. If the cursor points at records that have already been
+overwritten, either before or during the copy, the function returns -1 and leaves the
+cursor unchanged so the reader can resynchronize.
+*/
+int readChangeFeed(const ChangeFeed *feed, ChangeFeedCursor *cursor, ComplianceDelta *records, int maxRecords)
+{
+}
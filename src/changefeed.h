@@ -0,0 +1,50 @@
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include "bitmap.h"
+
+// Define the number of delta records kept in a change feed (must be a power of two)
+#define CHANGE_FEED_CAPACITY 1024
+
+// Define struct for a compact 16-byte delta record describing one mutation
+typedef struct
+{
+    unsigned int sequence;          // low 32 bits of the position of the record in the feed, starting at 0
+    unsigned int descriptionHash;   // low 32 bits of hashIncidentDescription
+    short index;                    // position of the incident before the mutation
+    unsigned char kind;             // ComplianceMutationKind
+    unsigned char type;             // ComplianceType
+    unsigned char oldSeverity;      // 0 for an add or a compaction
+    unsigned char newSeverity;      // 0 for a removal, tombstone or compaction
+} ComplianceDelta;
+
+// Define struct for a change feed attached to a management system
+typedef struct
+{
+    ComplianceDelta records[CHANGE_FEED_CAPACITY];
+    unsigned long nextSequence; // sequence of the next record to be written
+    ComplianceManagementSystem *system;
+} ChangeFeed;
+
+// Define struct for a reader position in a change feed
+typedef struct
+{
+    unsigned long sequence; // sequence of the next record to read
+} ChangeFeedCursor;
+
+// Function to attach an empty change feed to a management system
+int attachChangeFeed(ChangeFeed *feed, ComplianceManagementSystem *system);
+
+// Function to stop recording mutations into a change feed
+void detachChangeFeed(ChangeFeed *feed);
+
+// Function to find the oldest sequence that can still be read from a change feed
+unsigned long oldestChangeFeedSequence(const ChangeFeed *feed);
+
+// Function to position a cursor at a sequence of a change feed
+void seekChangeFeedCursor(ChangeFeedCursor *cursor, unsigned long sequence);
+
+// Function to read the next delta records of a change feed
+int readChangeFeed(const ChangeFeed *feed, ChangeFeedCursor *cursor, ComplianceDelta *records, int maxRecords);
+
+#endif
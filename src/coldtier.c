@@ -0,0 +1,81 @@
+#include "coldtier.h"
+
+/*
+This function initializes an empty cold tier. The number of incidents per block sets the
+trade-off between memory and lookup latency: descriptions can only reference text earlier in
+their own block, so larger blocks find more matches but a lookup has to decode the block from
+its start. The value is clamped to between 1 and COLD_MAX_INCIDENTS_PER_BLOCK. The function
+returns 0 on success and -1 if memory could not be allocated.
+*/
+int initColdTier(ColdTier *tier, int incidentsPerBlock)
+{
+}
+
+/*
+This function releases the memory owned by a cold tier and leaves it empty.
+*/
+void destroyColdTier(ColdTier *tier)
+{
+}
+
+/*
+This function trains the shared dictionary of a cold tier from the descriptions of a set of
+sample incidents. It counts how often each word occurs and fills the dictionary with the words
+that save the most bytes, placing the most valuable words last so they sit closest to the text
+being compressed. Tombstoned samples are skipped. The dictionary can only be trained while the
+cold tier is empty; the function returns 0 on success and -1 otherwise.
+*/
+int trainColdDictionary(ColdTier *tier, const ComplianceManagementSystem *samples)
+{
+}
+
+/*
+This function moves up to count of the oldest incidents of a management system into a cold
+tier. The type and severity of each incident are appended to the uncompressed columns and its
+description is compressed into the current block. Tombstoned incidents met on the way are not
+moved but are compacted along with the others: once the frozen prefix is known, it is removed
+from the system in one pass with removeComplianceIncidentsAt. It returns the number of incidents
+moved, which is smaller than count if the system runs out of incidents or memory could not be
+allocated.
+*/
+int freezeOldestIncidents(ColdTier *tier, ComplianceManagementSystem *system, int count)
+{
+}
+
+/*
+This function looks up an incident of a cold tier by its position, oldest first. The type
+and severity are read from the uncompressed columns, and the description is decompressed by
+decoding the block of the incident up to and including it. The compressed bytes decoded are
+added to decodedBytes, which shows the lookup latency side of the trade-off. It returns 0 on
+success and -1 if the index is out of range.
+*/
+int getColdIncident(ColdTier *tier, int index, ComplianceIncident *incident)
+{
+}
+
+/*
+This function calculates the average severity of the incidents in a cold tier. Only the
+severity column is read, so no description is decompressed. It returns 0 if the cold tier
+is empty.
+*/
+float calculateColdAverageSeverity(const ColdTier *tier)
+{
+}
+
+/*
+This function counts the incidents of a certain type in a cold tier by reading only the
+type column.
+*/
+int countColdIncidentsOfType(const ColdTier *tier, ComplianceType type)
+{
+}
+
+/*
+This function reports the number of bytes used to store the incidents of a cold tier: the
+two uncompressed columns, the compressed descriptions, the block offsets and the dictionary.
+Comparing it with numIncidents * sizeof(ComplianceIncident) for different block sizes shows
+the memory side of the trade-off, and decodedBytes the lookup latency side.
+*/
+int coldTierMemoryUsage(const ColdTier *tier)
+{
+}
@@ -0,0 +1,70 @@
+#ifndef COLDTIER_H
+#define COLDTIER_H
+
+#include <stdlib.h>
+#include "bitmap.h"
+
+// Define the maximum size of the shared dictionary used to compress descriptions
+#define COLD_DICTIONARY_SIZE 2048
+
+// Define the largest number of incidents that can share one compressed block
+#define COLD_MAX_INCIDENTS_PER_BLOCK 512
+
+// Define struct for the cold tier holding older incidents in compressed form
+typedef struct
+{
+    int incidentsPerBlock; // larger blocks compress better but take longer to look up
+    int dictionarySize;
+
+    // Uncompressed columns, one entry per incident
+    unsigned char *types;
+    unsigned char *severities;
+    int numIncidents;
+    int capacity;
+
+    // Compressed descriptions, one run of tokens per incident, grouped into blocks
+    unsigned char *data;
+    int dataSize;
+    int dataCapacity;
+    int *blockOffsets;
+    int numBlocks;
+    int blockCapacity;
+
+    // Dictionary followed by the plain text of the block being filled, and a scratch copy for lookups
+    char *window;
+    int windowLength;
+    char *scratch;
+
+    // Hash chains over the window, used to find matches while compressing
+    int *hashHead;
+    int *hashPrevious;
+
+    // Compressed bytes decoded by lookups so far, the lookup latency side of the block size trade-off
+    long decodedBytes;
+} ColdTier;
+
+// Function to initialize an empty cold tier
+int initColdTier(ColdTier *tier, int incidentsPerBlock);
+
+// Function to release the memory owned by a cold tier
+void destroyColdTier(ColdTier *tier);
+
+// Function to train the shared dictionary of a cold tier from sample incidents
+int trainColdDictionary(ColdTier *tier, const ComplianceManagementSystem *samples);
+
+// Function to move the oldest incidents of a management system into a cold tier
+int freezeOldestIncidents(ColdTier *tier, ComplianceManagementSystem *system, int count);
+
+// Function to look up an incident of a cold tier, decompressing its description
+int getColdIncident(ColdTier *tier, int index, ComplianceIncident *incident);
+
+// Function to calculate the average severity of the incidents in a cold tier
+float calculateColdAverageSeverity(const ColdTier *tier);
+
+// Function to count the incidents of a certain type in a cold tier
+int countColdIncidentsOfType(const ColdTier *tier, ComplianceType type);
+
+// Function to report the number of bytes used to store the incidents of a cold tier
+int coldTierMemoryUsage(const ColdTier *tier);
+
+#endif
@@ -0,0 +1,46 @@
+#include "escalation.h"
+
+/*
+This function attaches an escalation engine without rules to a management system. The per-type
+counts start from one scan of the incidents already in the system and are then kept up to date
+by a mutation listener, which evaluates the rules inside every add, severity update and removal.
+Events go to the callback if one is given, and to the event queue otherwise. It returns 0 on
+success and -1 if no more listeners can be registered.
+*/
+int attachEscalationEngine(EscalationEngine *engine, ComplianceManagementSystem *system, EscalationCallback callback, void *context)
+{
+}
+
+/*
+This function stops evaluating the rules of an escalation engine. Queued events can still be polled.
+*/
+void detachEscalationEngine(EscalationEngine *engine)
+{
+}
+
+/*
+This function registers an escalation rule, for example {SEVERITY_COUNT_ABOVE, DATA_PRIVACY, 8, 5}
+for more than 5 data privacy incidents of severity 8 or more, or {AVERAGE_SEVERITY_ABOVE,
+EMPLOYMENT_LAWS, 0, 7.5} for an employment law average above 7.5. The rule is inserted into its
+bucket in threshold order. A rule that already holds raises its event right away. It returns the
+id of the rule, or -1 if the rule is invalid or the engine is full.
+*/
+int addEscalationRule(EscalationEngine *engine, EscalationRule rule)
+{
+}
+
+/*
+This function checks whether an escalation rule currently holds. It returns 1 if it does, and 0
+if it does not or the rule id is unknown.
+*/
+int isEscalationRuleHolding(const EscalationEngine *engine, int ruleId)
+{
+}
+
+/*
+This function copies up to maxEvents queued escalation events into events, oldest first, and
+removes them from the queue. It returns the number of events copied.
+*/
+int pollEscalationEvents(EscalationEngine *engine, EscalationEvent *events, int maxEvents)
+{
+}
@@ -0,0 +1,81 @@
+#ifndef ESCALATION_H
+#define ESCALATION_H
+
+#include "bitmap.h"
+
+// Define the maximum number of rules an escalation engine can hold
+#define MAX_ESCALATION_RULES 1024
+
+// Define the number of events kept in the queue of an escalation engine
+#define ESCALATION_EVENT_CAPACITY 256
+
+// Define the number of rule buckets: one per type and minimum severity, then one per type for averages
+#define NUM_ESCALATION_BUCKETS 44
+
+// Define enum for the conditions an escalation rule can watch
+typedef enum
+{
+    SEVERITY_COUNT_ABOVE,  // more than threshold incidents of the type with severity >= minSeverity
+    AVERAGE_SEVERITY_ABOVE // average severity of the type above threshold
+} EscalationRuleKind;
+
+// Define struct for an escalation rule on one compliance type
+typedef struct
+{
+    EscalationRuleKind kind;
+    ComplianceType type;
+    int minSeverity; // only used by SEVERITY_COUNT_ABOVE
+    float threshold;
+} EscalationRule;
+
+// Define struct for an event raised when an escalation rule starts to hold
+typedef struct
+{
+    int ruleId;
+    ComplianceType type;
+    unsigned long sequence; // sequence of the mutation that made the rule hold, 0 when it held on registration
+    float value;            // count or average severity that crossed the threshold
+} EscalationEvent;
+
+// Define the callback type invoked for every escalation event
+typedef void (*EscalationCallback)(void *context, const EscalationEvent *event);
+
+// Define struct for an escalation engine attached to a management system
+typedef struct
+{
+    int severityAtLeast[4][11]; // number of incidents of each type with severity >= s, index 0 unused
+    int numIncidents[4];
+    int totalSeverity[4];
+
+    EscalationRule rules[MAX_ESCALATION_RULES];
+    int numRules;
+    short ruleOrder[MAX_ESCALATION_RULES];        // rule ids sorted by bucket, then by threshold
+    short bucketStart[NUM_ESCALATION_BUCKETS + 1]; // first position of each bucket in ruleOrder
+    short bucketHolding[NUM_ESCALATION_BUCKETS];   // number of rules at the start of each bucket that hold
+
+    EscalationCallback callback; // events are queued when no callback is set
+    void *callbackContext;
+    EscalationEvent events[ESCALATION_EVENT_CAPACITY];
+    unsigned long eventHead; // number of events ever read from the queue
+    unsigned long eventTail; // number of events ever written to the queue
+    unsigned long numDroppedEvents;
+
+    ComplianceManagementSystem *system;
+} EscalationEngine;
+
+// Function to attach an escalation engine without rules to a management system
+int attachEscalationEngine(EscalationEngine *engine, ComplianceManagementSystem *system, EscalationCallback callback, void *context);
+
+// Function to stop evaluating the rules of an escalation engine
+void detachEscalationEngine(EscalationEngine *engine);
+
+// Function to register an escalation rule
+int addEscalationRule(EscalationEngine *engine, EscalationRule rule);
+
+// Function to check whether an escalation rule currently holds
+int isEscalationRuleHolding(const EscalationEngine *engine, int ruleId);
+
+// Function to read the queued escalation events
+int pollEscalationEvents(EscalationEngine *engine, EscalationEvent *events, int maxEvents);
+
+#endif
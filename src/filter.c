@@ -0,0 +1,84 @@
+#include "filter.h"
+
+/*
+This function initializes a filter without predicates, which matches every incident.
+*/
+void initIncidentFilter(IncidentFilter *filter)
+{
+}
+
+/*
+This function adds a predicate requiring the incident type to be one of a set of types,
+given as FILTER_TYPE bits combined with |. It returns 0 on success and -1 if the filter is full.
+*/
+int filterTypeIn(IncidentFilter *filter, unsigned int typeSet)
+{
+}
+
+/*
+This function adds a predicate requiring the incident severity to be between minSeverity
+and maxSeverity, both included. It returns 0 on success and -1 if the filter is full.
+*/
+int filterSeverityBetween(IncidentFilter *filter, int minSeverity, int maxSeverity)
+{
+}
+
+/*
+This function adds a predicate requiring the incident description to contain a text. It
+returns 0 on success and -1 if the filter is full.
+*/
+int filterDescriptionContains(IncidentFilter *filter, const char *text)
+{
+}
+
+/*
+This function negates the predicate added last to a filter, so for example a type set
+becomes every type outside the set. It returns 0 on success and -1 if the filter is empty.
+*/
+int filterNegateLast(IncidentFilter *filter)
+{
+}
+
+/*
+This function compiles a filter into an evaluation pipeline. All type and severity predicates,
+however many there are, are folded into one table holding the allowed severities of each type,
+so the first stage of the pipeline costs the same for any combination of them. The description
+predicates are kept in a list that is only evaluated for incidents passing the table.
+*/
+void compileIncidentFilter(const IncidentFilter *filter, CompiledFilter *compiled)
+{
+}
+
+/*
+This function counts the incidents of a management system matching a compiled filter by
+adding up the population counts of the selection masks.
+*/
+int countMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function calculates the average severity of the incidents matching a compiled filter.
+It returns 0 if no incident matches.
+*/
+float averageSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function finds the matching incident with the highest severity. If several match with
+the same severity the first one is returned, like findHighestSeverityIncident does. If no
+incident matches, the function returns an empty incident with a data privacy type, a severity
+of 0 and the message "No matching incidents in the system".
+*/
+ComplianceIncident highestSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function writes the positions of the incidents matching a compiled filter into indices,
+in order, stopping after maxIndices positions. It returns the number of positions written.
+*/
+int collectMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system, int *indices, int maxIndices)
+{
+}
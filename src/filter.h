@@ -0,0 +1,77 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include "bitmap.h"
+
+// Define the maximum number of predicates in one filter
+#define MAX_FILTER_PREDICATES 8
+
+// Define a macro for the bit of a compliance type in a type set
+#define FILTER_TYPE(type) (1u << (type))
+
+// Define enum for the kinds of predicates a filter can hold
+typedef enum
+{
+    PREDICATE_TYPE_IN,
+    PREDICATE_SEVERITY_BETWEEN,
+    PREDICATE_DESCRIPTION_CONTAINS
+} FilterPredicateKind;
+
+// Define struct for a single predicate over an incident
+typedef struct
+{
+    FilterPredicateKind kind;
+    unsigned int typeSet; // FILTER_TYPE bits, for PREDICATE_TYPE_IN
+    int minSeverity;      // inclusive bounds, for PREDICATE_SEVERITY_BETWEEN
+    int maxSeverity;
+    char text[100]; // for PREDICATE_DESCRIPTION_CONTAINS
+    int negated;
+} FilterPredicate;
+
+// Define struct for a filter expression matching incidents that satisfy all of its predicates
+typedef struct
+{
+    FilterPredicate predicates[MAX_FILTER_PREDICATES];
+    int numPredicates;
+} IncidentFilter;
+
+// Define struct for a filter compiled into a severity table per type and a list of description checks
+typedef struct
+{
+    unsigned short allowedSeverities[4]; // bit s is set if severity s passes for that type
+    char descriptions[MAX_FILTER_PREDICATES][100];
+    int descriptionNegated[MAX_FILTER_PREDICATES];
+    int numDescriptions;
+} CompiledFilter;
+
+// Function to initialize a filter that matches every incident
+void initIncidentFilter(IncidentFilter *filter);
+
+// Function to require the incident type to be in a set of types
+int filterTypeIn(IncidentFilter *filter, unsigned int typeSet);
+
+// Function to require the incident severity to be within a range
+int filterSeverityBetween(IncidentFilter *filter, int minSeverity, int maxSeverity);
+
+// Function to require the incident description to contain a text
+int filterDescriptionContains(IncidentFilter *filter, const char *text);
+
+// Function to negate the predicate added last to a filter
+int filterNegateLast(IncidentFilter *filter);
+
+// Function to compile a filter into an evaluation pipeline
+void compileIncidentFilter(const IncidentFilter *filter, CompiledFilter *compiled);
+
+// Function to count the incidents of a management system matching a compiled filter
+int countMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system);
+
+// Function to calculate the average severity of the incidents matching a compiled filter
+float averageSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system);
+
+// Function to find the matching incident with the highest severity
+ComplianceIncident highestSeverityOfMatching(const CompiledFilter *compiled, const ComplianceManagementSystem *system);
+
+// Function to collect the positions of the incidents matching a compiled filter
+int collectMatchingIncidents(const CompiledFilter *compiled, const ComplianceManagementSystem *system, int *indices, int maxIndices);
+
+#endif
@@ -0,0 +1,32 @@
+#include <pthread.h>
+#include "groupby.h"
+
+/*
+This function computes the count, total, minimum, maximum, mean and full severity distribution
+of every compliance type in one pass over the incidents of a management system. The pass only
+counts incidents per type and severity; everything else is derived from those counts afterwards.
+The system is passed by pointer so nothing is copied.
+*/
+void groupIncidentsByType(const ComplianceManagementSystem *system, SeverityGroupTable *table)
+{
+}
+
+/*
+This function computes the same result table as groupIncidentsByType, but splits the incidents
+into one contiguous range per thread. Every thread counts its range into its own partial counts,
+and the partial counts are added up once all threads have finished. The number of threads is
+clamped to between 1 and MAX_GROUP_BY_THREADS. The function returns 0 on success and -1 if a
+thread could not be started, in which case the table is computed on the calling thread instead.
+*/
+int groupIncidentsByTypeParallel(const ComplianceManagementSystem *system, SeverityGroupTable *table, int numThreads)
+{
+}
+
+/*
+This function merges the severity statistics of one result table into another, for example
+to combine the tables of several management systems. The severity distributions are added up
+and every other statistic is derived again from them.
+*/
+void mergeSeverityGroupTables(SeverityGroupTable *table, const SeverityGroupTable *other)
+{
+}
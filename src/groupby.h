@@ -0,0 +1,35 @@
+#ifndef GROUPBY_H
+#define GROUPBY_H
+
+#include "bitmap.h"
+
+// Define the maximum number of threads used for partial aggregation
+#define MAX_GROUP_BY_THREADS 8
+
+// Define struct for the severity statistics of one compliance type
+typedef struct
+{
+    int count;
+    int totalSeverity;
+    int minSeverity; // 0 if the group is empty
+    int maxSeverity; // 0 if the group is empty
+    float meanSeverity;
+    int severityCounts[11]; // number of incidents per severity, index 0 unused
+} SeverityGroup;
+
+// Define struct for the result table of a group-by, one row per compliance type
+typedef struct
+{
+    SeverityGroup groups[4];
+} SeverityGroupTable;
+
+// Function to compute the severity statistics of every compliance type in one pass
+void groupIncidentsByType(const ComplianceManagementSystem *system, SeverityGroupTable *table);
+
+// Function to compute the severity statistics of every compliance type with several threads
+int groupIncidentsByTypeParallel(const ComplianceManagementSystem *system, SeverityGroupTable *table, int numThreads);
+
+// Function to merge the severity statistics of one result table into another
+void mergeSeverityGroupTables(SeverityGroupTable *table, const SeverityGroupTable *other);
+
+#endif
@@ -0,0 +1,67 @@
+#include "history.h"
+
+/*
+This function starts recording the severity history of a management system. The incidents
+already in the system are recorded as added at version 0, and every later add, severity update
+and removal is appended by a mutation listener with the sequence of the mutation as its version.
+Each change takes 11 bytes spread over four columns, instead of a copy of the incident; only
+the first change of each type and description also stores a copy of the description in the key
+columns. It returns 0 on success and -1 if the memory could not be allocated or no more
+listeners can be registered.
+*/
+int attachSeverityHistory(SeverityHistory *history, ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function stops recording the severity history of a management system. The history
+recorded so far can still be queried until it is destroyed.
+*/
+void detachSeverityHistory(SeverityHistory *history)
+{
+}
+
+/*
+This function releases the memory owned by a severity history. The history must be detached first.
+*/
+void destroySeverityHistory(SeverityHistory *history)
+{
+}
+
+/*
+This function returns the version of the latest change recorded in a severity history, which
+can be kept to query the state of the system at this point later on.
+*/
+unsigned long currentSeverityHistoryVersion(const SeverityHistory *history)
+{
+}
+
+/*
+This function finds the severity the incident with a given type and description had as of a
+version, that is after every change up to and including that version. The last entry at or
+before the version is located through the checkpoints, then the chain of entries of the
+incident is followed back from that entry to its first one, counting the incidents alive with
+each severity, without rebuilding any past state. Identical incidents share one chain, so if
+several were alive at that version the highest of their severities is returned, and removing one
+of them leaves the others in place. It returns 0 if no such incident was in the system at that
+version.
+*/
+int severityAsOf(const SeverityHistory *history, ComplianceType type, const char *description, unsigned long version)
+{
+}
+
+/*
+This function computes the number of incidents of each type and their total severity as of a
+version, by replaying the entries after the nearest checkpoint on top of its aggregate.
+*/
+SeverityAggregate aggregateSeverityAsOf(const SeverityHistory *history, unsigned long version)
+{
+}
+
+/*
+This function calculates the average severity of all incidents as of a version. It returns 0
+if there were no incidents at that version.
+*/
+float calculateAverageSeverityAsOf(const SeverityHistory *history, unsigned long version)
+{
+}
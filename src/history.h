@@ -0,0 +1,79 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdlib.h>
+#include "bitmap.h"
+
+// Define the number of history entries between two checkpoints
+#define SEVERITY_HISTORY_CHECKPOINT_INTERVAL 64
+
+// Define struct for the number of incidents and their total severity per compliance type
+typedef struct
+{
+    int numIncidents[4];
+    int totalSeverity[4];
+} SeverityAggregate;
+
+// Define struct for a checkpoint of a severity history
+typedef struct
+{
+    int firstEntry;              // first entry after the checkpoint
+    unsigned long sequence;      // sequence of the first entry
+    SeverityAggregate aggregate; // aggregate before the first entry
+} SeverityCheckpoint;
+
+// Define struct for the severity history of the incidents of a management system
+typedef struct
+{
+    // Columns, one element per history entry
+    unsigned short *sequenceDeltas; // sequence minus the sequence of the previous entry, 0 after a checkpoint
+    unsigned char *severities;      // old severity in the high nibble, new severity in the low nibble
+    int *keys;                      // key of the incident, that is its position in the key columns
+    int *previousEntries;           // previous entry with the same key, -1 for the first one
+    int numEntries;
+    int capacity;
+
+    SeverityCheckpoint *checkpoints;
+    int numCheckpoints;
+    int checkpointCapacity;
+
+    // Key columns, one element per distinct type and description
+    unsigned long long *keyHashes; // hashIncidentDescription of the description
+    unsigned char *keyTypes;
+    char **keyDescriptions; // copy of the description, compared on every lookup
+    int *latestEntries;     // latest entry with the key
+    int numKeys;
+    int keyCapacity;
+
+    // Open addressing table from a type and description to its key, -1 for an empty slot
+    int *keySlots;
+    int numSlots;
+
+    SeverityAggregate aggregate; // aggregate after the latest entry
+    unsigned long lastSequence;
+    int numDroppedEntries; // entries that could not be stored for lack of memory
+    ComplianceManagementSystem *system;
+} SeverityHistory;
+
+// Function to start recording the severity history of a management system
+int attachSeverityHistory(SeverityHistory *history, ComplianceManagementSystem *system);
+
+// Function to stop recording the severity history of a management system
+void detachSeverityHistory(SeverityHistory *history);
+
+// Function to release the memory owned by a severity history
+void destroySeverityHistory(SeverityHistory *history);
+
+// Function to get the version of the latest change recorded in a severity history
+unsigned long currentSeverityHistoryVersion(const SeverityHistory *history);
+
+// Function to find the severity an incident had as of a version
+int severityAsOf(const SeverityHistory *history, ComplianceType type, const char *description, unsigned long version);
+
+// Function to compute the number of incidents and their total severity as of a version
+SeverityAggregate aggregateSeverityAsOf(const SeverityHistory *history, unsigned long version);
+
+// Function to calculate the average severity of the incidents as of a version
+float calculateAverageSeverityAsOf(const SeverityHistory *history, unsigned long version);
+
+#endif
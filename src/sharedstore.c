@@ -0,0 +1,74 @@
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "sharedstore.h"
+
+/*
+This function creates a POSIX shared memory segment with the given name, sizes it for one
+management system and maps it for reading and writing. The system starts out empty. The name
+must start with a slash, as required by shm_open. A segment that already exists is never reset,
+since readers may be using it, so a second writer cannot take over a live store. It returns 0 on
+success and -1 if the segment already exists or could not be created or mapped.
+*/
+int createSharedStore(SharedStore *store, const char *name)
+{
+}
+
+/*
+This function maps an existing shared store segment read-only. It checks that the segment
+was initialized by a writer and has the layout this process expects. It returns 0 on success
+and -1 if the segment does not exist, could not be mapped or does not match.
+*/
+int openSharedStore(SharedStore *store, const char *name)
+{
+}
+
+/*
+This function unmaps the shared store segment of a handle. The segment itself stays
+available to other processes until it is unlinked.
+*/
+void closeSharedStore(SharedStore *store)
+{
+}
+
+/*
+This function removes the name of a shared store segment. Processes that still have it
+mapped keep their mapping. It returns 0 on success and -1 otherwise.
+*/
+int unlinkSharedStore(const char *name)
+{
+}
+
+/*
+This function starts changing the system of a shared store. It makes the sequence odd so that
+readers retry instead of using a half-changed system, and returns the shared system so it can be
+passed to the existing functions such as addComplianceIncident. Every call must be followed by
+endSharedStoreWrite. Only the process that created the store may write; for readers the function
+returns NULL.
+*/
+ComplianceManagementSystem *beginSharedStoreWrite(SharedStore *store)
+{
+}
+
+/*
+This function publishes the changes made since beginSharedStoreWrite by making the sequence
+even again.
+*/
+void endSharedStoreWrite(SharedStore *store)
+{
+}
+
+/*
+This function copies a consistent snapshot of the system of a shared store. It copies only the
+incidents in use, and retries whenever the writer was active before or during the copy. If the
+writer stays active for longer than SHARED_STORE_READ_TIMEOUT_MILLISECONDS, for example because
+its process died between beginSharedStoreWrite and endSharedStoreWrite, the function gives up
+instead of waiting forever. The snapshot can then be passed to the existing functions such as
+calculateAverageSeverity and findHighestSeverityIncident. It returns 0 on success and -1 on a
+timeout, in which case the snapshot must not be used.
+*/
+int readSharedStore(const SharedStore *store, ComplianceManagementSystem *snapshot)
+{
+}
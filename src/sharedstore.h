@@ -0,0 +1,51 @@
+#ifndef SHAREDSTORE_H
+#define SHAREDSTORE_H
+
+#include "bitmap.h"
+
+// Define the value identifying an initialized shared store segment
+#define SHARED_STORE_MAGIC 0x53534D43
+
+// Define how long a reader waits for the writer to finish before giving up
+#define SHARED_STORE_READ_TIMEOUT_MILLISECONDS 100
+
+// Define struct for the layout of a shared store segment. ComplianceManagementSystem holds no
+// pointers, so the segment can be mapped at a different address in every process.
+typedef struct
+{
+    unsigned int magic;
+    unsigned int segmentSize;
+    unsigned long sequence; // odd while the writer is changing the system
+    ComplianceManagementSystem system;
+} SharedStoreSegment;
+
+// Define struct for a process-local handle to a shared store
+typedef struct
+{
+    SharedStoreSegment *segment;
+    int writer;
+    char name[64];
+} SharedStore;
+
+// Function to create a new shared store segment and map it for writing
+int createSharedStore(SharedStore *store, const char *name);
+
+// Function to map an existing shared store segment for reading
+int openSharedStore(SharedStore *store, const char *name);
+
+// Function to unmap a shared store segment
+void closeSharedStore(SharedStore *store);
+
+// Function to remove a shared store segment once every process has closed it
+int unlinkSharedStore(const char *name);
+
+// Function to start changing the system of a shared store
+ComplianceManagementSystem *beginSharedStoreWrite(SharedStore *store);
+
+// Function to publish the changes made to the system of a shared store
+void endSharedStoreWrite(SharedStore *store);
+
+// Function to take a consistent snapshot of the system of a shared store
+int readSharedStore(const SharedStore *store, ComplianceManagementSystem *snapshot);
+
+#endif
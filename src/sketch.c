@@ -0,0 +1,101 @@
+#include <math.h>
+#include "sketch.h"
+
+/*
+This function initializes empty description sketches. The HyperLogLog precision sets the error
+of distinct counts and the Count-Min width and depth set the error of frequency estimates, at a
+memory cost of 2^hllPrecision bytes and countMinWidth * countMinDepth counters per type. It
+returns 0 on success and -1 if a parameter is outside 4 to MAX_HLL_PRECISION, 1 to
+MAX_COUNT_MIN_WIDTH or 1 to MAX_COUNT_MIN_DEPTH.
+*/
+int initDescriptionSketches(DescriptionSketches *sketches, int hllPrecision, int countMinWidth, int countMinDepth)
+{
+}
+
+/*
+This function registers description sketches as a mutation listener of a management system,
+so every incident accepted by addComplianceIncident is added to the sketches of its type. It
+returns 0 on success and -1 if no more listeners can be registered.
+*/
+int attachDescriptionSketches(DescriptionSketches *sketches, ComplianceManagementSystem *system)
+{
+}
+
+/*
+This function stops feeding description sketches from their management system. The sketches
+keep everything they have seen so far.
+*/
+void detachDescriptionSketches(DescriptionSketches *sketches)
+{
+}
+
+/*
+This function adds one description of a certain type to description sketches. The description
+hash updates one HyperLogLog register with the position of its first set bit, increments one
+Count-Min counter per row, and the new count estimate is offered to the heavy hitters.
+*/
+void addDescriptionToSketches(DescriptionSketches *sketches, ComplianceType type, const char *description)
+{
+}
+
+/*
+This function estimates the number of distinct descriptions of a certain type from the
+HyperLogLog registers, using linear counting while many registers are still empty.
+*/
+double estimateDistinctDescriptions(const DescriptionSketches *sketches, ComplianceType type)
+{
+}
+
+/*
+This function estimates how often a description of a certain type was added. The estimate is
+never lower than the true count.
+*/
+unsigned int estimateDescriptionCount(const DescriptionSketches *sketches, ComplianceType type, const char *description)
+{
+}
+
+/*
+This function copies the heavy hitters of a certain type, most frequent first, into the given
+array and returns how many were copied.
+*/
+int topDescriptions(const DescriptionSketches *sketches, ComplianceType type, HeavyHitter *heavyHitters, int maxHeavyHitters)
+{
+}
+
+/*
+This function merges other description sketches into the given ones, as if every description
+added to other had been added to them as well. HyperLogLog registers are merged by taking the
+maximum and Count-Min counters by adding. The heavy hitters of both sides are re-estimated from
+the merged counters and the most frequent ones are kept. The function returns 0 on success and
+-1 if the two sketches were built with different error bounds.
+*/
+int mergeDescriptionSketches(DescriptionSketches *sketches, const DescriptionSketches *other)
+{
+}
+
+/*
+This function calculates the number of bytes serializeDescriptionSketches needs for the given
+sketches.
+*/
+int descriptionSketchesSerializedSize(const DescriptionSketches *sketches)
+{
+}
+
+/*
+This function serializes description sketches into a buffer in a portable little-endian
+format, so sketches built by different stores or processes can be merged. Only the registers
+and counters in use are written. It returns the number of bytes written, or -1 if the buffer
+is too small.
+*/
+int serializeDescriptionSketches(const DescriptionSketches *sketches, unsigned char *buffer, int size)
+{
+}
+
+/*
+This function restores description sketches from a buffer written by
+serializeDescriptionSketches. The restored sketches are not attached to any management system.
+It returns 0 on success and -1 if the buffer is truncated or does not hold valid sketches.
+*/
+int deserializeDescriptionSketches(DescriptionSketches *sketches, const unsigned char *buffer, int size)
+{
+}
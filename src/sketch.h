@@ -0,0 +1,76 @@
+#ifndef SKETCH_H
+#define SKETCH_H
+
+#include "bitmap.h"
+
+// Define the largest HyperLogLog precision (number of register index bits)
+#define MAX_HLL_PRECISION 12
+
+// Define the largest Count-Min sketch dimensions
+#define MAX_COUNT_MIN_WIDTH 1024
+#define MAX_COUNT_MIN_DEPTH 5
+
+// Define the number of heavy hitters kept per compliance type
+#define SKETCH_TOP_K 10
+
+// Define struct for a description that recurs often, with its estimated count
+typedef struct
+{
+    char description[100];
+    unsigned long long hash;
+    unsigned int count;
+} HeavyHitter;
+
+// Define struct for the sketches of the descriptions of one compliance type
+typedef struct
+{
+    unsigned char registers[1 << MAX_HLL_PRECISION];
+    unsigned int counts[MAX_COUNT_MIN_DEPTH][MAX_COUNT_MIN_WIDTH];
+    HeavyHitter topK[SKETCH_TOP_K]; // min-heap on count
+    int numTopK;
+} TypeSketch;
+
+// Define struct for the description sketches of every compliance type
+typedef struct
+{
+    int hllPrecision;  // distinct counts are off by about 1.04 / sqrt(2^hllPrecision)
+    int countMinWidth; // counts are overestimated by at most 2.72 * total / countMinWidth
+    int countMinDepth; // with probability 1 - 2.72^-countMinDepth
+    TypeSketch types[4];
+    ComplianceManagementSystem *system;
+} DescriptionSketches;
+
+// Function to initialize empty description sketches with the given error bounds
+int initDescriptionSketches(DescriptionSketches *sketches, int hllPrecision, int countMinWidth, int countMinDepth);
+
+// Function to feed the incidents added to a management system into description sketches
+int attachDescriptionSketches(DescriptionSketches *sketches, ComplianceManagementSystem *system);
+
+// Function to stop feeding description sketches
+void detachDescriptionSketches(DescriptionSketches *sketches);
+
+// Function to add one description of a certain type to description sketches
+void addDescriptionToSketches(DescriptionSketches *sketches, ComplianceType type, const char *description);
+
+// Function to estimate the number of distinct descriptions of a certain type
+double estimateDistinctDescriptions(const DescriptionSketches *sketches, ComplianceType type);
+
+// Function to estimate how often a description of a certain type occurred
+unsigned int estimateDescriptionCount(const DescriptionSketches *sketches, ComplianceType type, const char *description);
+
+// Function to list the most frequent descriptions of a certain type
+int topDescriptions(const DescriptionSketches *sketches, ComplianceType type, HeavyHitter *heavyHitters, int maxHeavyHitters);
+
+// Function to merge description sketches built with the same error bounds
+int mergeDescriptionSketches(DescriptionSketches *sketches, const DescriptionSketches *other);
+
+// Function to calculate the number of bytes needed to serialize description sketches
+int descriptionSketchesSerializedSize(const DescriptionSketches *sketches);
+
+// Function to serialize description sketches into a buffer
+int serializeDescriptionSketches(const DescriptionSketches *sketches, unsigned char *buffer, int size);
+
+// Function to restore description sketches from a buffer
+int deserializeDescriptionSketches(DescriptionSketches *sketches, const unsigned char *buffer, int size);
+
+#endif
@@ -0,0 +1,107 @@
+#include "tenantpool.h"
+
+/*
+This function initializes an empty tenant pool. No memory is allocated until the
+first tenant store is created.
+*/
+void initTenantPool(TenantPool *pool)
+{
+}
+
+/*
+This function releases every slab owned by a tenant pool, together with the systems of the
+tenants still in use. All tenant stores created from the pool and their systems become invalid,
+and the pool is left empty so it can be reused.
+*/
+void destroyTenantPool(TenantPool *pool)
+{
+}
+
+/*
+This function creates an empty tenant store from the pool. If the free list is empty,
+the pool allocates one more slab and threads its stores onto the free list, so memory
+grows with the number of tenants actually in use. The store is popped from the free list,
+cleared and tagged with the given tenant id. Its system is only taken from the pool once the
+first incident is added. The function returns NULL if a new slab could not be allocated.
+*/
+TenantStore *createTenantStore(TenantPool *pool, int tenantId)
+{
+}
+
+/*
+This function returns a tenant store to the pool by giving its system back to the pool and
+pushing the store onto the free list. The slab memory is kept so the next tenant can be created,
+and can hold incidents, without allocating. A pointer to the system of the store must not be
+used after this call, since the system can be handed to another tenant.
+*/
+void destroyTenantStore(TenantPool *pool, TenantStore *store)
+{
+}
+
+/*
+This function adds a compliance incident to a tenant store. The tenant takes a system from the
+pool first if it holds none yet, and keeps it from then on, even once its incidents are removed,
+so a tenant moving between zero and one incident does not allocate or register listeners. The
+tenant aggregate is updated by the mutation listener of the store.
+*/
+void addTenantIncident(TenantStore *store, ComplianceIncident incident)
+{
+}
+
+/*
+This function updates the severity of a compliance incident in a tenant store with
+updateComplianceIncidentSeverity and returns its result. A tenant without a system returns
+-1, as for an incident that is not found.
+*/
+int updateTenantIncidentSeverity(TenantStore *store, ComplianceIncident incident, int newSeverity)
+{
+}
+
+/*
+This function removes all compliance incidents of a certain type from a tenant store
+and returns the number of incidents removed. The tenant keeps its system if it is left empty.
+*/
+int removeTenantIncidentsOfType(TenantStore *store, ComplianceType type)
+{
+}
+
+/*
+This function removes a compliance incident from a tenant store. The tenant keeps its system
+if it is left empty.
+*/
+void removeTenantIncident(TenantStore *store, ComplianceIncident incident)
+{
+}
+
+/*
+This function merges the aggregates of a set of tenant stores into a single aggregate.
+It only adds up the per-tenant counters, so the cost depends on the number of tenants
+and not on the number of incidents they hold.
+*/
+void rollupTenantAggregates(TenantStore **stores, int numStores, TenantAggregate *result)
+{
+}
+
+/*
+This function calculates the average severity recorded in an aggregate. It returns 0
+if the aggregate holds no incidents.
+*/
+float aggregateAverageSeverity(const TenantAggregate *aggregate)
+{
+}
+
+/*
+This function finds the highest severity recorded in an aggregate by walking the
+severity counts from 10 down to 1. It returns 0 if the aggregate holds no incidents.
+*/
+int aggregateHighestSeverity(const TenantAggregate *aggregate)
+{
+}
+
+/*
+This function counts the incidents of a certain type recorded in an aggregate by adding
+up the severity counts of that type.
+*/
+int aggregateCountOfType(const TenantAggregate *aggregate, ComplianceType type)
+{
+}
@@ -0,0 +1,107 @@
+#ifndef TENANTPOOL_H
+#define TENANTPOOL_H
+
+#include <stdlib.h>
+#include "bitmap.h"
+
+// Define the number of tenant stores carved out of each slab
+#define TENANT_SLAB_SIZE 16
+
+// Define the number of tenant systems carved out of each system slab
+#define TENANT_SYSTEM_SLAB_SIZE 4
+
+// Define struct for the running aggregates kept for each tenant
+typedef struct
+{
+    int severityCounts[4][11]; // number of incidents per compliance type and severity
+    int numIncidents;
+    int totalSeverity;
+} TenantAggregate;
+
+// Define struct for a tenant store handed out by the pool. The system is taken from the pool by
+// the first addTenantIncident, so a tenant that never held an incident costs a few hundred bytes.
+// From then on the system belongs to the tenant until destroyTenantStore, even while it is empty,
+// so it can be kept and changed directly: the aggregate follows every mutation through a mutation
+// listener registered once for the life of the system.
+typedef struct TenantStore
+{
+    ComplianceManagementSystem *system; // NULL until the tenant holds its first incident
+    TenantAggregate aggregate;
+    int tenantId; // -1 while the store sits on the free list
+    struct TenantStore *nextFree;
+    struct TenantPool *pool;
+} TenantStore;
+
+// Define struct for one slab of tenant stores
+typedef struct TenantSlab
+{
+    struct TenantSlab *next;
+    TenantStore stores[TENANT_SLAB_SIZE];
+} TenantSlab;
+
+// Define struct for a tenant system carved out of a system slab. The system comes first so a
+// pointer to it is also a pointer to its slot.
+typedef struct TenantSystemSlot
+{
+    ComplianceManagementSystem system;
+    struct TenantSystemSlot *nextFree;
+} TenantSystemSlot;
+
+// Define struct for one slab of tenant systems
+typedef struct TenantSystemSlab
+{
+    struct TenantSystemSlab *next;
+    TenantSystemSlot slots[TENANT_SYSTEM_SLAB_SIZE];
+} TenantSystemSlab;
+
+// Define struct for the pool that owns the slabs
+typedef struct TenantPool
+{
+    TenantSlab *slabs;
+    TenantStore *freeList;
+    int numSlabs;
+    int numTenants;
+
+    // Systems are carved out of their own slabs and reused through their own free list
+    TenantSystemSlab *systemSlabs;
+    TenantSystemSlot *freeSystems;
+    int numSystemSlabs;
+} TenantPool;
+
+// Function to initialize an empty tenant pool
+void initTenantPool(TenantPool *pool);
+
+// Function to release every slab owned by a tenant pool
+void destroyTenantPool(TenantPool *pool);
+
+// Function to create an empty tenant store from the pool
+TenantStore *createTenantStore(TenantPool *pool, int tenantId);
+
+// Function to return a tenant store to the pool
+void destroyTenantStore(TenantPool *pool, TenantStore *store);
+
+// Function to add a compliance incident to a tenant store
+void addTenantIncident(TenantStore *store, ComplianceIncident incident);
+
+// Function to update the severity of a compliance incident in a tenant store
+int updateTenantIncidentSeverity(TenantStore *store, ComplianceIncident incident, int newSeverity);
+
+// Function to remove all compliance incidents of a certain type from a tenant store
+int removeTenantIncidentsOfType(TenantStore *store, ComplianceType type);
+
+// Function to remove a compliance incident from a tenant store
+void removeTenantIncident(TenantStore *store, ComplianceIncident incident);
+
+// Function to merge the aggregates of a set of tenant stores
+void rollupTenantAggregates(TenantStore **stores, int numStores, TenantAggregate *result);
+
+// Function to calculate the average severity recorded in an aggregate
+float aggregateAverageSeverity(const TenantAggregate *aggregate);
+
+// Function to find the highest severity recorded in an aggregate
+int aggregateHighestSeverity(const TenantAggregate *aggregate);
+
+// Function to count the incidents of a certain type recorded in an aggregate
+int aggregateCountOfType(const TenantAggregate *aggregate, ComplianceType type);
+
+#endif
@@ -0,0 +1,70 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/arrowexport.h"
+
+class ArrowExportTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testExportIncidentsToArrow_ExportsColumns()
+    {
+        ComplianceManagementSystem system = {
+            {{{FINANCIAL_REGULATIONS, "Data breach in financial system", 8}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "", 3}}},
+            3};
+        struct ArrowSchema schema;
+        struct ArrowArray array;
+        TS_ASSERT_EQUALS(exportIncidentsToArrow(&system, &schema, &array), 0);
+        TS_ASSERT_EQUALS(strcmp(schema.format, "+s"), 0);
+        TS_ASSERT_EQUALS(schema.n_children, 3);
+        TS_ASSERT_EQUALS(strcmp(schema.children[0]->name, "type"), 0);
+        TS_ASSERT_EQUALS(strcmp(schema.children[0]->format, "i"), 0);
+        TS_ASSERT_EQUALS(strcmp(schema.children[1]->name, "severity"), 0);
+        TS_ASSERT_EQUALS(strcmp(schema.children[2]->name, "description"), 0);
+        TS_ASSERT_EQUALS(strcmp(schema.children[2]->format, "u"), 0);
+
+        // The export is a copy, so it is unaffected by later mutations
+        removeComplianceIncidentsOfType(&system, FINANCIAL_REGULATIONS);
+        TS_ASSERT_EQUALS(array.length, 3);
+        TS_ASSERT_EQUALS(array.null_count, 0);
+        TS_ASSERT_EQUALS(array.n_children, 3);
+        const int32_t *types = (const int32_t *)array.children[0]->buffers[1];
+        const int32_t *severities = (const int32_t *)array.children[1]->buffers[1];
+        const int32_t *offsets = (const int32_t *)array.children[2]->buffers[1];
+        const char *descriptions = (const char *)array.children[2]->buffers[2];
+        TS_ASSERT_EQUALS(types[0], FINANCIAL_REGULATIONS);
+        TS_ASSERT_EQUALS(types[2], ENVIRONMENTAL_REGULATIONS);
+        TS_ASSERT_EQUALS(severities[1], 6);
+        TS_ASSERT_EQUALS(offsets[0], 0);
+        TS_ASSERT_EQUALS(offsets[1], 31);
+        TS_ASSERT_EQUALS(offsets[2], 67);
+        TS_ASSERT_EQUALS(offsets[3], 67);
+        TS_ASSERT_EQUALS(strncmp(descriptions + offsets[1], "Unauthorized access to personal data", 36), 0);
+
+        schema.release(&schema);
+        array.release(&array);
+        TS_ASSERT(schema.release == NULL);
+        TS_ASSERT(array.release == NULL);
+    }
+    void testExportIncidentsToArrow_MovedColumnOutlivesParent()
+    {
+        ComplianceManagementSystem system = {
+            {{{EMPLOYMENT_LAWS, "Unpaid overtime", 8}},
+             {{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            3};
+        struct ArrowSchema schema;
+        struct ArrowArray array;
+        exportIncidentsToArrow(&system, &schema, &array);
+        struct ArrowArray descriptionColumn = *array.children[2];
+        array.children[2]->release = NULL;
+        array.release(&array);
+        schema.release(&schema);
+        const int32_t *offsets = (const int32_t *)descriptionColumn.buffers[1];
+        const char *descriptions = (const char *)descriptionColumn.buffers[2];
+        TS_ASSERT_EQUALS(descriptionColumn.length, 3);
+        TS_ASSERT_EQUALS(offsets[3] - offsets[2], 9);
+        TS_ASSERT_EQUALS(strncmp(descriptions + offsets[2], "Oil spill", 9), 0);
+        descriptionColumn.release(&descriptionColumn);
+        TS_ASSERT(descriptionColumn.release == NULL);
+    }
+};
@@ -0,0 +1,139 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/bitmapindex.h"
+
+class BitmapIndexTestSuite : public CxxTest::TestSuite
+{
+public:
+    // Checks that every bitmap of the index matches a fresh scan of the system
+    void assertIndexMatchesSystem(const IncidentBitmapIndex *index, const ComplianceManagementSystem *system)
+    {
+        for (int i = 0; i < 128; i++)
+        {
+            for (int type = 0; type < 4; type++)
+            {
+                int expected = i < system->numIncidents && system->incidents[i].dataPrivacyIncident.type == type;
+                TS_ASSERT_EQUALS((int)((index->typeBitmaps[type].words[i / 64] >> (i % 64)) & 1), expected);
+            }
+            for (int severity = 1; severity <= 10; severity++)
+            {
+                int expected = i < system->numIncidents && system->incidents[i].dataPrivacyIncident.severity == severity;
+                TS_ASSERT_EQUALS((int)((index->severityBitmaps[severity].words[i / 64] >> (i % 64)) & 1), expected);
+            }
+        }
+    }
+
+    void testAttachBitmapIndex_IndexesExistingIncidents()
+    {
+        ComplianceManagementSystem system = {
+            {{{FINANCIAL_REGULATIONS, "Data breach in financial system", 8}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data", 6}},
+             {{FINANCIAL_REGULATIONS, "Fraud", 4}}},
+            3};
+        IncidentBitmapIndex index;
+        TS_ASSERT_EQUALS(attachBitmapIndex(&index, &system), 0);
+        assertIndexMatchesSystem(&index, &system);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, FINANCIAL_REGULATIONS), 2);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 0);
+        detachBitmapIndex(&index);
+    }
+    void testBitmapIndex_FollowsMutations()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Leaked customer data", 7};
+        ComplianceIncident incident2 = {EMPLOYMENT_LAWS, "Unpaid overtime", 8};
+        ComplianceIncident incident3 = {FINANCIAL_REGULATIONS, "Late filing", 6};
+        ComplianceIncident repeated = {ENVIRONMENTAL_REGULATIONS, "Repeated finding", 3};
+        addComplianceIncident(&system, incident1);
+        addComplianceIncident(&system, incident2);
+        // Fill past the first bitmap word so that removals carry bits across words
+        for (int i = 0; i < 66; i++)
+        {
+            addComplianceIncident(&system, repeated);
+        }
+        addComplianceIncident(&system, incident2);
+        addComplianceIncident(&system, incident3);
+        assertIndexMatchesSystem(&index, &system);
+        updateComplianceIncidentSeverity(&system, incident3, 2);
+        removeComplianceIncident(&system, incident1);
+        removeComplianceIncidentsOfType(&system, EMPLOYMENT_LAWS);
+        removeComplianceIncidentAt(&system, 63);
+        assertIndexMatchesSystem(&index, &system);
+        detachBitmapIndex(&index);
+    }
+    void testBitmapOperations_CombinePredicates()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        ComplianceIncident incidents[5] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 8},
+                                           {DATA_PRIVACY, "Unencrypted backups", 5},
+                                           {FINANCIAL_REGULATIONS, "Late filing", 6}};
+        for (int i = 0; i < 5; i++)
+        {
+            addComplianceIncident(&system, incidents[i]);
+        }
+        IncidentBitmap privacyOrFinancial = bitmapOr(indexedIncidentsOfType(&index, DATA_PRIVACY),
+                                                     indexedIncidentsOfType(&index, FINANCIAL_REGULATIONS));
+        IncidentBitmap selected = bitmapAnd(privacyOrFinancial, indexedIncidentsWithSeverity(&index, 6, 9));
+        TS_ASSERT_EQUALS(bitmapCardinality(selected), 3);
+        TS_ASSERT_EQUALS(bitmapNextPosition(selected, 0), 0);
+        TS_ASSERT_EQUALS(bitmapNextPosition(selected, 1), 1);
+        TS_ASSERT_EQUALS(bitmapNextPosition(selected, 2), 4);
+        TS_ASSERT_EQUALS(bitmapNextPosition(selected, 5), -1);
+        IncidentBitmap lowPrivacy = bitmapAndNot(indexedIncidentsOfType(&index, DATA_PRIVACY), selected);
+        TS_ASSERT_EQUALS(bitmapCardinality(lowPrivacy), 1);
+        TS_ASSERT_EQUALS(bitmapNextPosition(lowPrivacy, 0), 3);
+        detachBitmapIndex(&index);
+    }
+    void testRemoveIndexedIncidentsOfType_RemovesEveryMatch()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        for (int i = 0; i < 90; i++)
+        {
+            ComplianceIncident incident = {i < 70 ? DATA_PRIVACY : EMPLOYMENT_LAWS, "Repeated finding", 5};
+            addComplianceIncident(&system, incident);
+        }
+        TS_ASSERT_EQUALS(removeIndexedIncidentsOfType(&index, DATA_PRIVACY), 70);
+        TS_ASSERT_EQUALS(system.numIncidents, 20);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, DATA_PRIVACY), 0);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 20);
+        assertIndexMatchesSystem(&index, &system);
+        detachBitmapIndex(&index);
+    }
+    void testRemoveIndexedIncidents_KeepsRemainingOrder()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        ComplianceIncident incidents[6] = {{DATA_PRIVACY, "Leaked customer data", 8},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 2},
+                                           {FINANCIAL_REGULATIONS, "Late filing", 7},
+                                           {DATA_PRIVACY, "Unencrypted backups", 3},
+                                           {ENVIRONMENTAL_REGULATIONS, "Chemical spill", 9},
+                                           {EMPLOYMENT_LAWS, "Missing contracts", 4}};
+        for (int i = 0; i < 6; i++)
+        {
+            addComplianceIncident(&system, incidents[i]);
+        }
+        IncidentBitmap severe = indexedIncidentsWithSeverity(&index, 7, 10);
+        // A position past the last incident is ignored
+        severe.words[1] |= 1ULL << 10;
+        TS_ASSERT_EQUALS(removeIndexedIncidents(&index, severe), 3);
+        TS_ASSERT_EQUALS(system.numIncidents, 3);
+        TS_ASSERT_EQUALS(memcmp(&system.incidents[0], &incidents[1], sizeof(ComplianceIncident)), 0);
+        TS_ASSERT_EQUALS(memcmp(&system.incidents[1], &incidents[3], sizeof(ComplianceIncident)), 0);
+        TS_ASSERT_EQUALS(memcmp(&system.incidents[2], &incidents[5], sizeof(ComplianceIncident)), 0);
+        assertIndexMatchesSystem(&index, &system);
+        detachBitmapIndex(&index);
+    }
+};
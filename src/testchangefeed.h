@@ -0,0 +1,133 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/changefeed.h"
+
+class ChangeFeedTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testChangeFeed_RecordsEveryMutation()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        static ChangeFeed feed;
+        TS_ASSERT_EQUALS(attachChangeFeed(&feed, &system), 0);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {FINANCIAL_REGULATIONS, "Fraud", 4};
+        addComplianceIncident(&system, incident1);
+        addComplianceIncident(&system, incident2);
+        updateComplianceIncidentSeverity(&system, incident2, 6);
+        removeComplianceIncident(&system, incident1);
+        detachChangeFeed(&feed);
+
+        ChangeFeedCursor cursor;
+        seekChangeFeedCursor(&cursor, 0);
+        ComplianceDelta records[8];
+        int numRecords = readChangeFeed(&feed, &cursor, records, 8);
+        TS_ASSERT_EQUALS(numRecords, 4);
+        TS_ASSERT_EQUALS(records[0].kind, INCIDENT_ADDED);
+        TS_ASSERT_EQUALS(records[0].newSeverity, 8);
+        TS_ASSERT_EQUALS(records[1].index, 1);
+        TS_ASSERT_EQUALS(records[2].kind, INCIDENT_SEVERITY_UPDATED);
+        TS_ASSERT_EQUALS(records[2].type, FINANCIAL_REGULATIONS);
+        TS_ASSERT_EQUALS(records[2].oldSeverity, 4);
+        TS_ASSERT_EQUALS(records[2].newSeverity, 6);
+        TS_ASSERT_EQUALS(records[3].kind, INCIDENT_REMOVED);
+        TS_ASSERT_EQUALS(records[3].index, 0);
+        TS_ASSERT_EQUALS(records[3].oldSeverity, 8);
+        TS_ASSERT_EQUALS(records[3].descriptionHash, (unsigned int)hashIncidentDescription("Data breach"));
+        TS_ASSERT_EQUALS(records[3].sequence, 3U);
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &cursor, records, 8), 0);
+        TS_ASSERT_EQUALS(sizeof(ComplianceDelta), 16U);
+    }
+    void testChangeFeed_IndependentCursorsResume()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        static ChangeFeed feed;
+        attachChangeFeed(&feed, &system);
+        ComplianceIncident incident = {EMPLOYMENT_LAWS, "Harassment", 5};
+        addComplianceIncident(&system, incident);
+        addComplianceIncident(&system, incident);
+        addComplianceIncident(&system, incident);
+        detachChangeFeed(&feed);
+
+        ChangeFeedCursor fast, slow;
+        seekChangeFeedCursor(&fast, 0);
+        seekChangeFeedCursor(&slow, 2);
+        ComplianceDelta records[2];
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &fast, records, 2), 2);
+        TS_ASSERT_EQUALS(records[1].sequence, 1U);
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &slow, records, 2), 1);
+        TS_ASSERT_EQUALS(records[0].sequence, 2U);
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &fast, records, 2), 1);
+        TS_ASSERT_EQUALS(fast.sequence, 3UL);
+    }
+    void testChangeFeed_DetectsLaggingReader()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        static ChangeFeed feed;
+        attachChangeFeed(&feed, &system);
+        ComplianceIncident incident = {DATA_PRIVACY, "Data breach", 5};
+        addComplianceIncident(&system, incident);
+        for (int i = 0; i < CHANGE_FEED_CAPACITY; i++)
+        {
+            updateComplianceIncidentSeverity(&system, incident, i % 10 + 1);
+        }
+        detachChangeFeed(&feed);
+
+        ChangeFeedCursor cursor;
+        seekChangeFeedCursor(&cursor, 0);
+        ComplianceDelta records[4];
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &cursor, records, 4), -1);
+        TS_ASSERT_EQUALS(cursor.sequence, 0UL);
+
+        // The record in the slot the writer fills next counts as lost as well
+        seekChangeFeedCursor(&cursor, 1);
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &cursor, records, 4), -1);
+        TS_ASSERT_EQUALS(oldestChangeFeedSequence(&feed), 2UL);
+        seekChangeFeedCursor(&cursor, oldestChangeFeedSequence(&feed));
+        TS_ASSERT_EQUALS(readChangeFeed(&feed, &cursor, records, 4), 4);
+        TS_ASSERT_EQUALS(records[0].sequence, 2U);
+    }
+    void testChangeFeed_ManySystemsKeepTheirOwnListeners()
+    {
+        static ComplianceManagementSystem systems[40];
+        static ChangeFeed feeds[40];
+        for (int i = 0; i < 40; i++)
+        {
+            systems[i].numIncidents = 0;
+            TS_ASSERT_EQUALS(attachChangeFeed(&feeds[i], &systems[i]), 0);
+        }
+        for (int i = 0; i < 40; i += 3)
+        {
+            detachChangeFeed(&feeds[i]);
+        }
+        ComplianceIncident incident = {ENVIRONMENTAL_REGULATIONS, "Oil spill", 9};
+        for (int i = 0; i < 40; i++)
+        {
+            for (int j = 0; j <= i % 4; j++)
+            {
+                addComplianceIncident(&systems[i], incident);
+            }
+        }
+        for (int i = 0; i < 40; i++)
+        {
+            TS_ASSERT_EQUALS(feeds[i].nextSequence, i % 3 == 0 ? 0UL : (unsigned long)(i % 4 + 1));
+            if (i % 3 != 0)
+            {
+                detachChangeFeed(&feeds[i]);
+            }
+        }
+    }
+    void testDetachChangeFeed_StopsRecording()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        static ChangeFeed feed;
+        attachChangeFeed(&feed, &system);
+        detachChangeFeed(&feed);
+        ComplianceIncident incident = {DATA_PRIVACY, "Data breach", 5};
+        addComplianceIncident(&system, incident);
+        TS_ASSERT_EQUALS(feed.nextSequence, 0UL);
+    }
+};
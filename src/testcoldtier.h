@@ -0,0 +1,149 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/coldtier.h"
+
+class ColdTierTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testFreezeOldestIncidents_MovesIncidents()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Unauthorized access to personal data at the head office", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported financial statements at the head office", 9}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the warehouse", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Illegal dumping of hazardous waste at the warehouse", 10}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data at the warehouse", 5}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the head office", 4}}},
+            6};
+        ColdTier tier;
+        TS_ASSERT_EQUALS(initColdTier(&tier, 4), 0);
+        TS_ASSERT_EQUALS(trainColdDictionary(&tier, &system), 0);
+        TS_ASSERT_EQUALS(freezeOldestIncidents(&tier, &system, 5), 5);
+        TS_ASSERT_EQUALS(tier.numIncidents, 5);
+        TS_ASSERT_EQUALS(tier.numBlocks, 2);
+        TS_ASSERT_EQUALS(system.numIncidents, 1);
+        TS_ASSERT(std::strcmp(system.incidents[0].dataPrivacyIncident.description, "Discrimination in hiring practices at the head office") == 0);
+        TS_ASSERT_EQUALS(trainColdDictionary(&tier, &system), -1);
+        destroyColdTier(&tier);
+    }
+    void testGetColdIncident_RoundTripsDescriptions()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Unauthorized access to personal data at the head office", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported financial statements at the head office", 9}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the warehouse", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Illegal dumping of hazardous waste at the warehouse", 10}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data at the warehouse", 5}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the head office", 4}},
+             {{FINANCIAL_REGULATIONS, "Late filing", 2}}},
+            7};
+        ComplianceManagementSystem original = system;
+        ColdTier tier;
+        initColdTier(&tier, 3);
+        trainColdDictionary(&tier, &system);
+        TS_ASSERT_EQUALS(freezeOldestIncidents(&tier, &system, 200), 7);
+        TS_ASSERT_EQUALS(system.numIncidents, 0);
+        for (int i = 0; i < 7; i++)
+        {
+            ComplianceIncident incident;
+            TS_ASSERT_EQUALS(getColdIncident(&tier, i, &incident), 0);
+            TS_ASSERT_EQUALS(incident.type, original.incidents[i].dataPrivacyIncident.type);
+            TS_ASSERT_EQUALS(incident.severity, original.incidents[i].dataPrivacyIncident.severity);
+            TS_ASSERT(std::strcmp(incident.description, original.incidents[i].dataPrivacyIncident.description) == 0);
+        }
+        ComplianceIncident incident;
+        TS_ASSERT_EQUALS(getColdIncident(&tier, 7, &incident), -1);
+        destroyColdTier(&tier);
+    }
+    void testColdAggregates_ReadColumnsOnly()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported earnings", 9}},
+             {{DATA_PRIVACY, "Unencrypted backups", 5}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            4};
+        ColdTier tier;
+        initColdTier(&tier, 8);
+        freezeOldestIncidents(&tier, &system, 4);
+        TS_ASSERT_EQUALS(calculateColdAverageSeverity(&tier), 7.75);
+        TS_ASSERT_EQUALS(countColdIncidentsOfType(&tier, DATA_PRIVACY), 2);
+        TS_ASSERT_EQUALS(countColdIncidentsOfType(&tier, ENVIRONMENTAL_REGULATIONS), 1);
+        destroyColdTier(&tier);
+    }
+    void testColdTierMemoryUsage_LargerBlocksCompressBetter()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Unauthorized access to personal data at the head office", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported financial statements at the head office", 9}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the warehouse", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Illegal dumping of hazardous waste at the warehouse", 10}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data at the warehouse", 5}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the head office", 4}}},
+            6};
+        ComplianceManagementSystem copy = system;
+        ColdTier small, large;
+        initColdTier(&small, 1);
+        initColdTier(&large, 64);
+        trainColdDictionary(&small, &system);
+        trainColdDictionary(&large, &system);
+        freezeOldestIncidents(&small, &system, 6);
+        freezeOldestIncidents(&large, &copy, 6);
+        TS_ASSERT_LESS_THAN(coldTierMemoryUsage(&small), 6 * (int)sizeof(ComplianceIncident));
+        TS_ASSERT_LESS_THAN(coldTierMemoryUsage(&large), coldTierMemoryUsage(&small));
+        destroyColdTier(&small);
+        destroyColdTier(&large);
+    }
+    void testGetColdIncident_SmallerBlocksDecodeLess()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Unauthorized access to personal data at the head office", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported financial statements at the head office", 9}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the warehouse", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Illegal dumping of hazardous waste at the warehouse", 10}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data at the warehouse", 5}},
+             {{EMPLOYMENT_LAWS, "Discrimination in hiring practices at the head office", 4}}},
+            6};
+        ComplianceManagementSystem copy = system;
+        ColdTier small, large;
+        initColdTier(&small, 1);
+        initColdTier(&large, 64);
+        trainColdDictionary(&small, &system);
+        trainColdDictionary(&large, &system);
+        freezeOldestIncidents(&small, &system, 6);
+        freezeOldestIncidents(&large, &copy, 6);
+        TS_ASSERT_EQUALS(small.decodedBytes, 0);
+        ComplianceIncident incident;
+        getColdIncident(&small, 0, &incident);
+        getColdIncident(&large, 0, &incident);
+        TS_ASSERT_EQUALS(small.decodedBytes, large.decodedBytes);
+
+        // Every later lookup in the large block decodes the incidents before it again
+        for (int i = 1; i < 6; i++)
+        {
+            getColdIncident(&small, i, &incident);
+            getColdIncident(&large, i, &incident);
+        }
+        TS_ASSERT_LESS_THAN(small.decodedBytes, large.decodedBytes);
+        TS_ASSERT_LESS_THAN_EQUALS(small.decodedBytes, (long)small.dataSize);
+        destroyColdTier(&small);
+        destroyColdTier(&large);
+    }
+    void testFreezeOldestIncidents_CompactsTombstonesOnTheWay()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported earnings", -9}},
+             {{DATA_PRIVACY, "Unencrypted backups", 5}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 8}}},
+            5};
+        ColdTier tier;
+        initColdTier(&tier, 8);
+        TS_ASSERT_EQUALS(freezeOldestIncidents(&tier, &system, 3), 3);
+        TS_ASSERT_EQUALS(tier.numIncidents, 3);
+        TS_ASSERT_EQUALS(countColdIncidentsOfType(&tier, FINANCIAL_REGULATIONS), 0);
+        TS_ASSERT_EQUALS(system.numIncidents, 1);
+        TS_ASSERT(std::strcmp(system.incidents[0].dataPrivacyIncident.description, "Unpaid overtime") == 0);
+        destroyColdTier(&tier);
+    }
+};
@@ -0,0 +1,145 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/escalation.h"
+
+// Counts the events delivered to a callback and remembers the last one
+typedef struct
+{
+    int numEvents;
+    EscalationEvent lastEvent;
+} EscalationRecorder;
+
+static void recordEscalationEvent(void *context, const EscalationEvent *event)
+{
+    EscalationRecorder *recorder = (EscalationRecorder *)context;
+    recorder->numEvents++;
+    recorder->lastEvent = *event;
+}
+
+class EscalationTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testSeverityCountRule_FiresOnceWhenCrossed()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        EscalationEngine engine;
+        EscalationRecorder recorder;
+        memset(&recorder, 0, sizeof(EscalationRecorder));
+        TS_ASSERT_EQUALS(attachEscalationEngine(&engine, &system, recordEscalationEvent, &recorder), 0);
+        EscalationRule rule = {SEVERITY_COUNT_ABOVE, DATA_PRIVACY, 8, 5};
+        int ruleId = addEscalationRule(&engine, rule);
+        TS_ASSERT_EQUALS(ruleId, 0);
+        for (int i = 0; i < 5; i++)
+        {
+            ComplianceIncident incident = {DATA_PRIVACY, "Leaked customer data", 9};
+            addComplianceIncident(&system, incident);
+        }
+        ComplianceIncident minor = {DATA_PRIVACY, "Misplaced form", 3};
+        addComplianceIncident(&system, minor);
+        ComplianceIncident other = {FINANCIAL_REGULATIONS, "Misreported earnings", 10};
+        addComplianceIncident(&system, other);
+        TS_ASSERT_EQUALS(recorder.numEvents, 0);
+        updateComplianceIncidentSeverity(&system, minor, 8);
+        TS_ASSERT_EQUALS(recorder.numEvents, 1);
+        TS_ASSERT_EQUALS(recorder.lastEvent.ruleId, ruleId);
+        TS_ASSERT_EQUALS(recorder.lastEvent.type, DATA_PRIVACY);
+        TS_ASSERT_EQUALS(recorder.lastEvent.value, 6);
+        TS_ASSERT_EQUALS(isEscalationRuleHolding(&engine, ruleId), 1);
+
+        // Staying above the threshold does not fire again, dropping below rearms the rule
+        ComplianceIncident incident = {DATA_PRIVACY, "Leaked customer data", 9};
+        addComplianceIncident(&system, incident);
+        TS_ASSERT_EQUALS(recorder.numEvents, 1);
+        removeComplianceIncidentsOfType(&system, DATA_PRIVACY);
+        TS_ASSERT_EQUALS(isEscalationRuleHolding(&engine, ruleId), 0);
+        for (int i = 0; i < 6; i++)
+        {
+            addComplianceIncident(&system, incident);
+        }
+        TS_ASSERT_EQUALS(recorder.numEvents, 2);
+        detachEscalationEngine(&engine);
+    }
+    void testAverageSeverityRule_QueuesEvents()
+    {
+        ComplianceManagementSystem system = {
+            {{{EMPLOYMENT_LAWS, "Unpaid overtime", 6}},
+             {{EMPLOYMENT_LAWS, "Missing contracts", 8}}},
+            2};
+        EscalationEngine engine;
+        attachEscalationEngine(&engine, &system, NULL, NULL);
+        EscalationRule low = {AVERAGE_SEVERITY_ABOVE, EMPLOYMENT_LAWS, 0, 6.5};
+        EscalationRule high = {AVERAGE_SEVERITY_ABOVE, EMPLOYMENT_LAWS, 0, 7.5};
+        int lowId = addEscalationRule(&engine, low);
+        int highId = addEscalationRule(&engine, high);
+        EscalationEvent events[4];
+        TS_ASSERT_EQUALS(pollEscalationEvents(&engine, events, 4), 1);
+        TS_ASSERT_EQUALS(events[0].ruleId, lowId);
+        TS_ASSERT_EQUALS(events[0].sequence, 0);
+        ComplianceIncident incident = {EMPLOYMENT_LAWS, "Discrimination in hiring", 10};
+        addComplianceIncident(&system, incident);
+        TS_ASSERT_EQUALS(pollEscalationEvents(&engine, events, 4), 1);
+        TS_ASSERT_EQUALS(events[0].ruleId, highId);
+        TS_ASSERT_DELTA(events[0].value, 8.0, 0.001);
+        removeComplianceIncident(&system, incident);
+        TS_ASSERT_EQUALS(isEscalationRuleHolding(&engine, highId), 0);
+        TS_ASSERT_EQUALS(isEscalationRuleHolding(&engine, lowId), 1);
+        TS_ASSERT_EQUALS(pollEscalationEvents(&engine, events, 4), 0);
+        detachEscalationEngine(&engine);
+    }
+    void testManyRules_MatchRescan()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        EscalationEngine engine;
+        attachEscalationEngine(&engine, &system, NULL, NULL);
+        for (int i = 0; i < MAX_ESCALATION_RULES; i++)
+        {
+            EscalationRule rule;
+            rule.kind = i % 2 == 0 ? SEVERITY_COUNT_ABOVE : AVERAGE_SEVERITY_ABOVE;
+            rule.type = (ComplianceType)(i % 4);
+            rule.minSeverity = i % 10 + 1;
+            rule.threshold = rule.kind == SEVERITY_COUNT_ABOVE ? (float)(i % 30) : (float)(i % 90) / 10;
+            TS_ASSERT_EQUALS(addEscalationRule(&engine, rule), i);
+        }
+        EscalationRule extra = {SEVERITY_COUNT_ABOVE, DATA_PRIVACY, 1, 1};
+        TS_ASSERT_EQUALS(addEscalationRule(&engine, extra), -1);
+        ComplianceIncident incidents[5] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 2},
+                                           {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10},
+                                           {DATA_PRIVACY, "Unencrypted backups", 4}};
+        for (int i = 0; i < 300; i++)
+        {
+            if (system.numIncidents == 100 || i % 7 == 6)
+            {
+                removeComplianceIncidentAt(&system, i % system.numIncidents);
+            }
+            else
+            {
+                addComplianceIncident(&system, incidents[i % 5]);
+            }
+        }
+        for (int i = 0; i < MAX_ESCALATION_RULES; i++)
+        {
+            const EscalationRule *rule = &engine.rules[i];
+            int count = 0;
+            int totalSeverity = 0;
+            int numOfType = 0;
+            for (int j = 0; j < system.numIncidents; j++)
+            {
+                const ComplianceIncident *incident = &system.incidents[j].dataPrivacyIncident;
+                if (incident->type == rule->type)
+                {
+                    count += incident->severity >= rule->minSeverity;
+                    totalSeverity += incident->severity;
+                    numOfType++;
+                }
+            }
+            float value = rule->kind == SEVERITY_COUNT_ABOVE ? (float)count
+                          : numOfType == 0                   ? 0.0f
+                                                             : (float)totalSeverity / numOfType;
+            TS_ASSERT_EQUALS(isEscalationRuleHolding(&engine, i), value > rule->threshold);
+        }
+        detachEscalationEngine(&engine);
+    }
+};
@@ -0,0 +1,130 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/filter.h"
+
+class FilterTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testCompileIncidentFilter_EmptyFilterMatchesAll()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported quarterly earnings", 9}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 8}},
+             {{DATA_PRIVACY, "Unencrypted customer backups", 5}},
+             {{FINANCIAL_REGULATIONS, "Late filing", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            6};
+        IncidentFilter filter;
+        CompiledFilter compiled;
+        initIncidentFilter(&filter);
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(countMatchingIncidents(&compiled, &system), 6);
+        TS_ASSERT_EQUALS(averageSeverityOfMatching(&compiled, &system), calculateAverageSeverity(system));
+    }
+    void testTypeAndSeverityFilter()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported quarterly earnings", 9}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 8}},
+             {{DATA_PRIVACY, "Unencrypted customer backups", 5}},
+             {{FINANCIAL_REGULATIONS, "Late filing", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            6};
+        IncidentFilter filter;
+        CompiledFilter compiled;
+        initIncidentFilter(&filter);
+        filterTypeIn(&filter, FILTER_TYPE(DATA_PRIVACY) | FILTER_TYPE(FINANCIAL_REGULATIONS));
+        filterSeverityBetween(&filter, 6, 9);
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(countMatchingIncidents(&compiled, &system), 3);
+        TS_ASSERT_EQUALS(averageSeverityOfMatching(&compiled, &system), 22.0f / 3);
+        ComplianceIncident highest = highestSeverityOfMatching(&compiled, &system);
+        TS_ASSERT_EQUALS(highest.severity, 9);
+        TS_ASSERT(std::strcmp(highest.description, "Misreported quarterly earnings") == 0);
+        int indices[6];
+        TS_ASSERT_EQUALS(collectMatchingIncidents(&compiled, &system, indices, 6), 3);
+        TS_ASSERT_EQUALS(indices[0], 0);
+        TS_ASSERT_EQUALS(indices[1], 1);
+        TS_ASSERT_EQUALS(indices[2], 4);
+    }
+    void testDescriptionFilterAndNegation()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported quarterly earnings", 9}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 8}},
+             {{DATA_PRIVACY, "Unencrypted customer backups", 5}},
+             {{FINANCIAL_REGULATIONS, "Late filing", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            6};
+        IncidentFilter filter;
+        CompiledFilter compiled;
+        initIncidentFilter(&filter);
+        filterDescriptionContains(&filter, "customer");
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(countMatchingIncidents(&compiled, &system), 2);
+        filterSeverityBetween(&filter, 6, 10);
+        filterNegateLast(&filter);
+        compileIncidentFilter(&filter, &compiled);
+        int indices[6];
+        TS_ASSERT_EQUALS(collectMatchingIncidents(&compiled, &system, indices, 6), 1);
+        TS_ASSERT_EQUALS(indices[0], 3);
+        filterNegateLast(&filter);
+        filterDescriptionContains(&filter, "backups");
+        filterNegateLast(&filter);
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(collectMatchingIncidents(&compiled, &system, indices, 6), 1);
+        TS_ASSERT_EQUALS(indices[0], 0);
+    }
+    void testHighestSeverityOfMatching_NoMatch()
+    {
+        ComplianceManagementSystem system = {
+            {{{DATA_PRIVACY, "Leaked customer data", 7}},
+             {{FINANCIAL_REGULATIONS, "Misreported quarterly earnings", 9}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 8}},
+             {{DATA_PRIVACY, "Unencrypted customer backups", 5}},
+             {{FINANCIAL_REGULATIONS, "Late filing", 6}},
+             {{ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}}},
+            6};
+        IncidentFilter filter;
+        CompiledFilter compiled;
+        initIncidentFilter(&filter);
+        filterTypeIn(&filter, FILTER_TYPE(EMPLOYMENT_LAWS));
+        filterSeverityBetween(&filter, 9, 10);
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(countMatchingIncidents(&compiled, &system), 0);
+        TS_ASSERT_EQUALS(averageSeverityOfMatching(&compiled, &system), 0.0);
+        TS_ASSERT_EQUALS(highestSeverityOfMatching(&compiled, &system).severity, 0);
+    }
+    void testFilter_SpansSeveralBlocks()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        ComplianceIncident first = {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10};
+        ComplianceIncident recurring = {DATA_PRIVACY, "Recurring audit finding", 4};
+        ComplianceIncident last = {ENVIRONMENTAL_REGULATIONS, "Chemical leak", 7};
+        addComplianceIncident(&system, first);
+        for (int i = 0; i < 66; i++)
+        {
+            addComplianceIncident(&system, recurring);
+        }
+        addComplianceIncident(&system, last);
+        IncidentFilter filter;
+        CompiledFilter compiled;
+        initIncidentFilter(&filter);
+        filterTypeIn(&filter, FILTER_TYPE(ENVIRONMENTAL_REGULATIONS));
+        compileIncidentFilter(&filter, &compiled);
+        TS_ASSERT_EQUALS(countMatchingIncidents(&compiled, &system), 2);
+        int indices[100];
+        TS_ASSERT_EQUALS(collectMatchingIncidents(&compiled, &system, indices, 100), 2);
+        TS_ASSERT_EQUALS(indices[0], 0);
+        TS_ASSERT_EQUALS(indices[1], 67);
+        TS_ASSERT_EQUALS(filterTypeIn(&filter, 0), 0);
+        for (int i = 2; i < MAX_FILTER_PREDICATES; i++)
+        {
+            filterSeverityBetween(&filter, 1, 10);
+        }
+        TS_ASSERT_EQUALS(filterSeverityBetween(&filter, 1, 10), -1);
+    }
+};
@@ -0,0 +1,65 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/groupby.h"
+
+class GroupByTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testGroupIncidentsByType_ComputesStatistics()
+    {
+        ComplianceManagementSystem system = {
+            {{{FINANCIAL_REGULATIONS, "Data breach in financial system", 8}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data", 6}},
+             {{FINANCIAL_REGULATIONS, "Misreported financials", 3}},
+             {{DATA_PRIVACY, "Leaked user data", 6}},
+             {{FINANCIAL_REGULATIONS, "Fraud", 10}}},
+            5};
+        SeverityGroupTable table;
+        groupIncidentsByType(&system, &table);
+        SeverityGroup financial = table.groups[FINANCIAL_REGULATIONS];
+        TS_ASSERT_EQUALS(financial.count, 3);
+        TS_ASSERT_EQUALS(financial.totalSeverity, 21);
+        TS_ASSERT_EQUALS(financial.minSeverity, 3);
+        TS_ASSERT_EQUALS(financial.maxSeverity, 10);
+        TS_ASSERT_EQUALS(financial.meanSeverity, 7.0);
+        TS_ASSERT_EQUALS(table.groups[DATA_PRIVACY].severityCounts[6], 2);
+        TS_ASSERT_EQUALS(table.groups[DATA_PRIVACY].minSeverity, 6);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].count, 0);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].maxSeverity, 0);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].meanSeverity, 0.0);
+    }
+    void testGroupIncidentsByTypeParallel_MatchesSinglePass()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        ComplianceIncident incidents[5] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 2},
+                                           {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10},
+                                           {DATA_PRIVACY, "Unencrypted backups", 4}};
+        // Fill the system so that every thread count splits it into several ranges
+        for (int i = 0; i < 100; i++)
+        {
+            addComplianceIncident(&system, incidents[i % 5]);
+        }
+        SeverityGroupTable expected, table;
+        groupIncidentsByType(&system, &expected);
+        for (int threads = 0; threads <= MAX_GROUP_BY_THREADS + 1; threads++)
+        {
+            TS_ASSERT_EQUALS(groupIncidentsByTypeParallel(&system, &table, threads), 0);
+            TS_ASSERT_EQUALS(memcmp(&table, &expected, sizeof(SeverityGroupTable)), 0);
+        }
+    }
+    void testMergeSeverityGroupTables()
+    {
+        ComplianceManagementSystem system1 = {{{EMPLOYMENT_LAWS, "Harassment", 9}}, 1};
+        ComplianceManagementSystem system2 = {{{EMPLOYMENT_LAWS, "Unpaid overtime", 2}}, 1};
+        SeverityGroupTable table, other;
+        groupIncidentsByType(&system1, &table);
+        groupIncidentsByType(&system2, &other);
+        mergeSeverityGroupTables(&table, &other);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].count, 2);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].minSeverity, 2);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].maxSeverity, 9);
+        TS_ASSERT_EQUALS(table.groups[EMPLOYMENT_LAWS].meanSeverity, 5.5);
+    }
+};
@@ -0,0 +1,140 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/history.h"
+
+class SeverityHistoryTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testSeverityAsOf_FollowsUpdatesAndRemovals()
+    {
+        ComplianceManagementSystem system = {
+            {{{FINANCIAL_REGULATIONS, "Data breach in financial system", 8}},
+             {{DATA_PRIVACY, "Unauthorized access to personal data", 6}}},
+            2};
+        SeverityHistory history;
+        TS_ASSERT_EQUALS(attachSeverityHistory(&history, &system), 0);
+        unsigned long attached = currentSeverityHistoryVersion(&history);
+        ComplianceIncident breach = system.incidents[0].dataPrivacyIncident;
+        updateComplianceIncidentSeverity(&system, breach, 3);
+        unsigned long lowered = currentSeverityHistoryVersion(&history);
+        breach.severity = 3;
+        updateComplianceIncidentSeverity(&system, breach, 10);
+        unsigned long raised = currentSeverityHistoryVersion(&history);
+        removeComplianceIncidentsOfType(&system, FINANCIAL_REGULATIONS);
+        unsigned long removed = currentSeverityHistoryVersion(&history);
+        TS_ASSERT(attached < lowered && lowered < raised && raised < removed);
+
+        TS_ASSERT_EQUALS(severityAsOf(&history, FINANCIAL_REGULATIONS, "Data breach in financial system", attached), 8);
+        TS_ASSERT_EQUALS(severityAsOf(&history, FINANCIAL_REGULATIONS, "Data breach in financial system", lowered), 3);
+        TS_ASSERT_EQUALS(severityAsOf(&history, FINANCIAL_REGULATIONS, "Data breach in financial system", raised), 10);
+        TS_ASSERT_EQUALS(severityAsOf(&history, FINANCIAL_REGULATIONS, "Data breach in financial system", removed), 0);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Unauthorized access to personal data", removed), 6);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Data breach in financial system", raised), 0);
+
+        TS_ASSERT_DELTA(calculateAverageSeverityAsOf(&history, attached), 7.0, 0.001);
+        TS_ASSERT_DELTA(calculateAverageSeverityAsOf(&history, raised), 8.0, 0.001);
+        TS_ASSERT_DELTA(calculateAverageSeverityAsOf(&history, removed), 6.0, 0.001);
+        detachSeverityHistory(&history);
+        destroySeverityHistory(&history);
+    }
+    void testSeverityAsOf_CollidingHashesKeepOwnHistories()
+    {
+        // These descriptions share the low 30 bits of their hash, and so the home slot of their key
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Incident 84573", 4};
+        ComplianceIncident incident2 = {DATA_PRIVACY, "Incident 19188", 9};
+        TS_ASSERT_EQUALS(hashIncidentDescription(incident1.description) & 0x3FFFFFFF,
+                         hashIncidentDescription(incident2.description) & 0x3FFFFFFF);
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        SeverityHistory history;
+        attachSeverityHistory(&history, &system);
+        addComplianceIncident(&system, incident1);
+        addComplianceIncident(&system, incident2);
+        unsigned long added = currentSeverityHistoryVersion(&history);
+        updateComplianceIncidentSeverity(&system, incident1, 6);
+        removeComplianceIncident(&system, incident2);
+        unsigned long removed = currentSeverityHistoryVersion(&history);
+        TS_ASSERT_EQUALS(history.numKeys, 2);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Incident 84573", added), 4);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Incident 19188", added), 9);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Incident 84573", removed), 6);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Incident 19188", removed), 0);
+        TS_ASSERT_EQUALS(severityAsOf(&history, DATA_PRIVACY, "Incident 1", removed), 0);
+        detachSeverityHistory(&history);
+        destroySeverityHistory(&history);
+    }
+    void testSeverityAsOf_DuplicateIncidentsCountedSeparately()
+    {
+        ComplianceManagementSystem system = {
+            {{{EMPLOYMENT_LAWS, "Unpaid overtime", 5}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 5}},
+             {{EMPLOYMENT_LAWS, "Unpaid overtime", 3}}},
+            3};
+        SeverityHistory history;
+        attachSeverityHistory(&history, &system);
+        unsigned long attached = currentSeverityHistoryVersion(&history);
+        ComplianceIncident overtime = {EMPLOYMENT_LAWS, "Unpaid overtime", 5};
+        removeComplianceIncident(&system, overtime);
+        unsigned long removedOne = currentSeverityHistoryVersion(&history);
+        removeComplianceIncident(&system, overtime);
+        unsigned long removedBoth = currentSeverityHistoryVersion(&history);
+        overtime.severity = 3;
+        updateComplianceIncidentSeverity(&system, overtime, 9);
+        unsigned long raised = currentSeverityHistoryVersion(&history);
+        removeComplianceIncident(&system, system.incidents[0].employmentLawsIncident);
+        unsigned long removedAll = currentSeverityHistoryVersion(&history);
+        TS_ASSERT_EQUALS(history.numKeys, 1);
+        TS_ASSERT_EQUALS(severityAsOf(&history, EMPLOYMENT_LAWS, "Unpaid overtime", attached), 5);
+        TS_ASSERT_EQUALS(severityAsOf(&history, EMPLOYMENT_LAWS, "Unpaid overtime", removedOne), 5);
+        TS_ASSERT_EQUALS(severityAsOf(&history, EMPLOYMENT_LAWS, "Unpaid overtime", removedBoth), 3);
+        TS_ASSERT_EQUALS(severityAsOf(&history, EMPLOYMENT_LAWS, "Unpaid overtime", raised), 9);
+        TS_ASSERT_EQUALS(severityAsOf(&history, EMPLOYMENT_LAWS, "Unpaid overtime", removedAll), 0);
+        detachSeverityHistory(&history);
+        destroySeverityHistory(&history);
+    }
+    void testAggregateSeverityAsOf_MatchesReplay()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        SeverityHistory history;
+        attachSeverityHistory(&history, &system);
+        ComplianceIncident incidents[4] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 2},
+                                           {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10}};
+        unsigned long versions[1000];
+        SeverityAggregate expected[1000];
+        for (int i = 0; i < 1000; i++)
+        {
+            if (system.numIncidents == 100 || i % 5 == 4)
+            {
+                removeComplianceIncidentAt(&system, i * 31 % system.numIncidents);
+            }
+            else if (i % 5 == 3 && system.numIncidents > 0)
+            {
+                ComplianceIncident incident = system.incidents[i * 17 % system.numIncidents].dataPrivacyIncident;
+                updateComplianceIncidentSeverity(&system, incident, i % 10 + 1);
+            }
+            else
+            {
+                addComplianceIncident(&system, incidents[i % 4]);
+            }
+            versions[i] = currentSeverityHistoryVersion(&history);
+            memset(&expected[i], 0, sizeof(SeverityAggregate));
+            for (int j = 0; j < system.numIncidents; j++)
+            {
+                const ComplianceIncident *incident = &system.incidents[j].dataPrivacyIncident;
+                expected[i].numIncidents[incident->type]++;
+                expected[i].totalSeverity[incident->type] += incident->severity;
+            }
+        }
+        TS_ASSERT_EQUALS(history.numDroppedEntries, 0);
+        TS_ASSERT_LESS_THAN(1000 / SEVERITY_HISTORY_CHECKPOINT_INTERVAL, history.numCheckpoints);
+        for (int i = 0; i < 1000; i++)
+        {
+            SeverityAggregate aggregate = aggregateSeverityAsOf(&history, versions[i]);
+            TS_ASSERT_SAME_DATA(&aggregate, &expected[i], sizeof(SeverityAggregate));
+        }
+        detachSeverityHistory(&history);
+        destroySeverityHistory(&history);
+    }
+};
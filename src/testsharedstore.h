@@ -0,0 +1,103 @@
+#include <cxxtest/TestSuite.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../src/sharedstore.h"
+
+class SharedStoreTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testSharedStore_ReaderSeesPublishedWrites()
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "/cms-test-%d", (int)getpid());
+        SharedStore writer, reader;
+        TS_ASSERT_EQUALS(createSharedStore(&writer, name), 0);
+        TS_ASSERT_EQUALS(openSharedStore(&reader, name), 0);
+
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {FINANCIAL_REGULATIONS, "Fraud", 4};
+        ComplianceManagementSystem *system = beginSharedStoreWrite(&writer);
+        addComplianceIncident(system, incident1);
+        addComplianceIncident(system, incident2);
+        endSharedStoreWrite(&writer);
+
+        ComplianceManagementSystem snapshot;
+        TS_ASSERT_EQUALS(readSharedStore(&reader, &snapshot), 0);
+        TS_ASSERT_EQUALS(snapshot.numIncidents, 2);
+        TS_ASSERT_EQUALS(calculateAverageSeverity(snapshot), 6.0);
+        TS_ASSERT_EQUALS(findHighestSeverityIncident(snapshot).severity, 8);
+        TS_ASSERT(beginSharedStoreWrite(&reader) == NULL);
+
+        closeSharedStore(&reader);
+        closeSharedStore(&writer);
+        TS_ASSERT_EQUALS(unlinkSharedStore(name), 0);
+    }
+    void testSharedStore_ReadFromAnotherProcess()
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "/cms-test-fork-%d", (int)getpid());
+        SharedStore writer;
+        TS_ASSERT_EQUALS(createSharedStore(&writer, name), 0);
+        ComplianceIncident incident = {EMPLOYMENT_LAWS, "Harassment", 9};
+        addComplianceIncident(beginSharedStoreWrite(&writer), incident);
+        endSharedStoreWrite(&writer);
+
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            SharedStore reader;
+            ComplianceManagementSystem snapshot;
+            if (openSharedStore(&reader, name) != 0)
+            {
+                _exit(2);
+            }
+            if (readSharedStore(&reader, &snapshot) != 0)
+            {
+                _exit(3);
+            }
+            _exit(snapshot.numIncidents == 1 && findHighestSeverityIncident(snapshot).severity == 9 ? 0 : 1);
+        }
+        int status = -1;
+        waitpid(pid, &status, 0);
+        TS_ASSERT(WIFEXITED(status));
+        TS_ASSERT_EQUALS(WEXITSTATUS(status), 0);
+
+        closeSharedStore(&writer);
+        unlinkSharedStore(name);
+    }
+    void testCreateSharedStore_ExistingSegment()
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "/cms-test-existing-%d", (int)getpid());
+        SharedStore writer, second;
+        TS_ASSERT_EQUALS(createSharedStore(&writer, name), 0);
+        ComplianceIncident incident = {DATA_PRIVACY, "Data breach", 8};
+        addComplianceIncident(beginSharedStoreWrite(&writer), incident);
+        endSharedStoreWrite(&writer);
+        TS_ASSERT_EQUALS(createSharedStore(&second, name), -1);
+        TS_ASSERT_EQUALS(writer.segment->system.numIncidents, 1);
+        TS_ASSERT_EQUALS(writer.segment->sequence, 2UL);
+        closeSharedStore(&writer);
+        unlinkSharedStore(name);
+    }
+    void testReadSharedStore_TimesOutOnAbandonedWrite()
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "/cms-test-abandoned-%d", (int)getpid());
+        SharedStore writer, reader;
+        TS_ASSERT_EQUALS(createSharedStore(&writer, name), 0);
+        TS_ASSERT_EQUALS(openSharedStore(&reader, name), 0);
+        // The writer starts a change and never publishes it, as if its process had died
+        beginSharedStoreWrite(&writer);
+        ComplianceManagementSystem snapshot;
+        TS_ASSERT_EQUALS(readSharedStore(&reader, &snapshot), -1);
+        closeSharedStore(&reader);
+        closeSharedStore(&writer);
+        unlinkSharedStore(name);
+    }
+    void testOpenSharedStore_MissingSegment()
+    {
+        SharedStore reader;
+        TS_ASSERT_EQUALS(openSharedStore(&reader, "/cms-test-missing-segment"), -1);
+    }
+};
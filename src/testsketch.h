@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/sketch.h"
+
+class SketchTestSuite : public CxxTest::TestSuite
+{
+public:
+    // Adds count incidents through addComplianceIncident, emptying the system whenever it fills up
+    void feedIncidents(ComplianceManagementSystem *system, ComplianceType type, const char *prefix, int numDistinct, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (system->numIncidents == 100)
+            {
+                system->numIncidents = 0;
+            }
+            ComplianceIncident incident;
+            incident.type = type;
+            snprintf(incident.description, 100, "%s %d", prefix, i % numDistinct);
+            incident.severity = 5;
+            addComplianceIncident(system, incident);
+        }
+    }
+
+    void testInitDescriptionSketches_RejectsBadBounds()
+    {
+        static DescriptionSketches sketches;
+        TS_ASSERT_EQUALS(initDescriptionSketches(&sketches, 3, 256, 4), -1);
+        TS_ASSERT_EQUALS(initDescriptionSketches(&sketches, 10, MAX_COUNT_MIN_WIDTH + 1, 4), -1);
+        TS_ASSERT_EQUALS(initDescriptionSketches(&sketches, 10, 256, 0), -1);
+        TS_ASSERT_EQUALS(initDescriptionSketches(&sketches, 10, 256, 4), 0);
+    }
+    void testAttachDescriptionSketches_EstimatesDistinctPerType()
+    {
+        static DescriptionSketches sketches;
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        initDescriptionSketches(&sketches, 12, 512, 4);
+        TS_ASSERT_EQUALS(attachDescriptionSketches(&sketches, &system), 0);
+        feedIncidents(&system, DATA_PRIVACY, "Leaked record batch", 2000, 5000);
+        feedIncidents(&system, FINANCIAL_REGULATIONS, "Late filing", 3, 300);
+        detachDescriptionSketches(&sketches);
+        feedIncidents(&system, FINANCIAL_REGULATIONS, "Not counted", 50, 50);
+        TS_ASSERT_DELTA(estimateDistinctDescriptions(&sketches, DATA_PRIVACY), 2000, 2000 * 0.05);
+        TS_ASSERT_DELTA(estimateDistinctDescriptions(&sketches, FINANCIAL_REGULATIONS), 3, 0.5);
+        TS_ASSERT_EQUALS(estimateDistinctDescriptions(&sketches, EMPLOYMENT_LAWS), 0.0);
+    }
+    void testTopDescriptions_FindsHeavyHitters()
+    {
+        static DescriptionSketches sketches;
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        initDescriptionSketches(&sketches, 10, 1024, 4);
+        attachDescriptionSketches(&sketches, &system);
+        feedIncidents(&system, EMPLOYMENT_LAWS, "Rare issue", 500, 500);
+        feedIncidents(&system, EMPLOYMENT_LAWS, "Unpaid overtime", 1, 80);
+        feedIncidents(&system, EMPLOYMENT_LAWS, "Missing safety training", 1, 40);
+        detachDescriptionSketches(&sketches);
+        HeavyHitter heavyHitters[SKETCH_TOP_K];
+        TS_ASSERT_EQUALS(topDescriptions(&sketches, EMPLOYMENT_LAWS, heavyHitters, 2), 2);
+        TS_ASSERT(std::strcmp(heavyHitters[0].description, "Unpaid overtime 0") == 0);
+        TS_ASSERT(std::strcmp(heavyHitters[1].description, "Missing safety training 0") == 0);
+        TS_ASSERT(heavyHitters[0].count >= 80);
+        TS_ASSERT(estimateDescriptionCount(&sketches, EMPLOYMENT_LAWS, "Missing safety training 0") >= 40);
+    }
+    void testSerializeAndMergeDescriptionSketches()
+    {
+        static DescriptionSketches first, second, restored;
+        ComplianceManagementSystem system1, system2;
+        system1.numIncidents = 0;
+        system2.numIncidents = 0;
+        initDescriptionSketches(&first, 8, 128, 3);
+        initDescriptionSketches(&second, 8, 128, 3);
+        attachDescriptionSketches(&first, &system1);
+        attachDescriptionSketches(&second, &system2);
+        feedIncidents(&system1, ENVIRONMENTAL_REGULATIONS, "Oil spill", 1, 30);
+        feedIncidents(&system2, ENVIRONMENTAL_REGULATIONS, "Oil spill", 1, 20);
+        feedIncidents(&system2, ENVIRONMENTAL_REGULATIONS, "Chemical leak", 1, 25);
+        detachDescriptionSketches(&first);
+        detachDescriptionSketches(&second);
+
+        static unsigned char buffer[1 << 16];
+        int size = serializeDescriptionSketches(&second, buffer, sizeof(buffer));
+        TS_ASSERT_EQUALS(size, descriptionSketchesSerializedSize(&second));
+        TS_ASSERT_EQUALS(serializeDescriptionSketches(&second, buffer, size - 1), -1);
+        TS_ASSERT_EQUALS(deserializeDescriptionSketches(&restored, buffer, size - 1), -1);
+        TS_ASSERT_EQUALS(deserializeDescriptionSketches(&restored, buffer, size), 0);
+        TS_ASSERT_EQUALS(mergeDescriptionSketches(&first, &restored), 0);
+
+        HeavyHitter heavyHitters[SKETCH_TOP_K];
+        TS_ASSERT_EQUALS(topDescriptions(&first, ENVIRONMENTAL_REGULATIONS, heavyHitters, SKETCH_TOP_K), 2);
+        TS_ASSERT(std::strcmp(heavyHitters[0].description, "Oil spill 0") == 0);
+        TS_ASSERT(heavyHitters[0].count >= 50);
+        TS_ASSERT_DELTA(estimateDistinctDescriptions(&first, ENVIRONMENTAL_REGULATIONS), 2, 0.5);
+
+        static DescriptionSketches other;
+        initDescriptionSketches(&other, 9, 128, 3);
+        TS_ASSERT_EQUALS(mergeDescriptionSketches(&first, &other), -1);
+    }
+};
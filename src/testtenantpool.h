@@ -0,0 +1,184 @@
+#include <cxxtest/TestSuite.h>
+#include "../src/tenantpool.h"
+
+class TenantPoolTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testCreateTenantStore_AllocatesSlabOnDemand()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TS_ASSERT_EQUALS(pool.numSlabs, 0);
+        TenantStore *store = createTenantStore(&pool, 7);
+        TS_ASSERT(store != NULL);
+        TS_ASSERT_EQUALS(store->tenantId, 7);
+        TS_ASSERT(store->system == NULL);
+        TS_ASSERT_EQUALS(pool.numSlabs, 1);
+        TS_ASSERT_EQUALS(pool.numTenants, 1);
+        destroyTenantPool(&pool);
+    }
+    void testCreateTenantStore_GrowsAndReusesFreedStores()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *stores[TENANT_SLAB_SIZE + 1];
+        for (int i = 0; i < TENANT_SLAB_SIZE + 1; i++)
+        {
+            stores[i] = createTenantStore(&pool, i);
+        }
+        TS_ASSERT_EQUALS(pool.numSlabs, 2);
+        TS_ASSERT_EQUALS(pool.numTenants, TENANT_SLAB_SIZE + 1);
+        destroyTenantStore(&pool, stores[3]);
+        TS_ASSERT_EQUALS(pool.numTenants, TENANT_SLAB_SIZE);
+        TenantStore *reused = createTenantStore(&pool, 99);
+        TS_ASSERT(reused == stores[3]);
+        TS_ASSERT_EQUALS(reused->tenantId, 99);
+        TS_ASSERT_EQUALS(pool.numSlabs, 2);
+        destroyTenantPool(&pool);
+    }
+    ////////////////////////////////////////////////////////////
+    void testAddTenantIncident_UpdatesAggregate()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *store = createTenantStore(&pool, 1);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {FINANCIAL_REGULATIONS, "Fraud", 4};
+        ComplianceIncident invalid = {FINANCIAL_REGULATIONS, "Fraud", 12};
+        addTenantIncident(store, incident1);
+        addTenantIncident(store, incident2);
+        addTenantIncident(store, invalid);
+        TS_ASSERT_EQUALS(store->system->numIncidents, 2);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 2);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 12);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&store->aggregate), 8);
+        TS_ASSERT_EQUALS(aggregateCountOfType(&store->aggregate, FINANCIAL_REGULATIONS), 1);
+        destroyTenantPool(&pool);
+    }
+    void testUpdateTenantIncidentSeverity_MovesSeverity()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *store = createTenantStore(&pool, 1);
+        ComplianceIncident incident = {EMPLOYMENT_LAWS, "Harassment", 3};
+        addTenantIncident(store, incident);
+        TS_ASSERT_EQUALS(updateTenantIncidentSeverity(store, incident, 9), 0);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&store->aggregate), 9);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 9);
+        TS_ASSERT_EQUALS(updateTenantIncidentSeverity(store, incident, 11), 1);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 9);
+        destroyTenantPool(&pool);
+    }
+    void testRemoveTenantIncidents_UpdatesAggregate()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *store = createTenantStore(&pool, 1);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {FINANCIAL_REGULATIONS, "Fraud", 4};
+        ComplianceIncident incident3 = {EMPLOYMENT_LAWS, "Harassment", 6};
+        addTenantIncident(store, incident1);
+        addTenantIncident(store, incident2);
+        addTenantIncident(store, incident3);
+        ComplianceManagementSystem *system = store->system;
+        TS_ASSERT_EQUALS(removeTenantIncidentsOfType(store, DATA_PRIVACY), 1);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 2);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&store->aggregate), 6);
+        removeTenantIncident(store, store->system->incidents[0].financialRegulationsIncident);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 1);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 6);
+        removeTenantIncident(store, incident3);
+        TS_ASSERT(store->system == system);
+        TS_ASSERT_EQUALS(system->numIncidents, 0);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 0);
+
+        // The emptied system stays attached, so direct mutations are still followed
+        addComplianceIncident(system, incident1);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 1);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 8);
+        destroyTenantPool(&pool);
+    }
+    void testTenantSystems_CarvedFromPoolAndReused()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *first = createTenantStore(&pool, 1);
+        TenantStore *second = createTenantStore(&pool, 2);
+        ComplianceIncident incident = {DATA_PRIVACY, "Data breach", 8};
+        TS_ASSERT_EQUALS(pool.numSystemSlabs, 0);
+        addTenantIncident(first, incident);
+        TS_ASSERT_EQUALS(pool.numSystemSlabs, 1);
+        ComplianceManagementSystem *system = first->system;
+        for (int i = 0; i < 3; i++)
+        {
+            removeTenantIncident(first, incident);
+            addTenantIncident(first, incident);
+        }
+        TS_ASSERT(first->system == system);
+        TS_ASSERT_EQUALS(first->aggregate.numIncidents, 1);
+
+        // A destroyed tenant hands its system to the next tenant that needs one
+        destroyTenantStore(&pool, first);
+        addTenantIncident(second, incident);
+        TS_ASSERT(second->system == system);
+        TS_ASSERT_EQUALS(second->system->numIncidents, 1);
+        TS_ASSERT_EQUALS(second->aggregate.numIncidents, 1);
+        TS_ASSERT_EQUALS(pool.numSystemSlabs, 1);
+        destroyTenantPool(&pool);
+    }
+    void testTenantAggregate_FollowsDirectMutations()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *store = createTenantStore(&pool, 1);
+        ComplianceIncident invalid = {DATA_PRIVACY, "Data breach", 0};
+        addTenantIncident(store, invalid);
+        TS_ASSERT_EQUALS(store->system->numIncidents, 0);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 0);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {ENVIRONMENTAL_REGULATIONS, "Oil spill", 3};
+        addTenantIncident(store, incident1);
+        addComplianceIncident(store->system, incident2);
+        updateComplianceIncidentSeverity(store->system, incident2, 10);
+        removeComplianceIncidentsOfType(store->system, DATA_PRIVACY);
+        TS_ASSERT_EQUALS(store->aggregate.numIncidents, 1);
+        TS_ASSERT_EQUALS(store->aggregate.totalSeverity, 10);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&store->aggregate), 10);
+        TS_ASSERT_EQUALS(aggregateCountOfType(&store->aggregate, DATA_PRIVACY), 0);
+        destroyTenantPool(&pool);
+    }
+    ////////////////////////////////////////////////////////////
+    void testRollupTenantAggregates_MergesTenants()
+    {
+        TenantPool pool;
+        initTenantPool(&pool);
+        TenantStore *stores[3];
+        stores[0] = createTenantStore(&pool, 1);
+        stores[1] = createTenantStore(&pool, 2);
+        stores[2] = createTenantStore(&pool, 3);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Data breach", 8};
+        ComplianceIncident incident2 = {DATA_PRIVACY, "Leaked user data", 2};
+        ComplianceIncident incident3 = {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10};
+        addTenantIncident(stores[0], incident1);
+        addTenantIncident(stores[1], incident2);
+        addTenantIncident(stores[2], incident3);
+        TenantAggregate rollup;
+        rollupTenantAggregates(stores, 2, &rollup);
+        TS_ASSERT_EQUALS(rollup.numIncidents, 2);
+        TS_ASSERT_EQUALS(aggregateAverageSeverity(&rollup), 5.0);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&rollup), 8);
+        TS_ASSERT_EQUALS(aggregateCountOfType(&rollup, DATA_PRIVACY), 2);
+        rollupTenantAggregates(stores, 3, &rollup);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&rollup), 10);
+        TS_ASSERT_EQUALS(aggregateCountOfType(&rollup, ENVIRONMENTAL_REGULATIONS), 1);
+        destroyTenantPool(&pool);
+    }
+    void testRollupTenantAggregates_Empty()
+    {
+        TenantAggregate rollup;
+        rollupTenantAggregates(NULL, 0, &rollup);
+        TS_ASSERT_EQUALS(rollup.numIncidents, 0);
+        TS_ASSERT_EQUALS(aggregateAverageSeverity(&rollup), 0.0);
+        TS_ASSERT_EQUALS(aggregateHighestSeverity(&rollup), 0);
+    }
+};
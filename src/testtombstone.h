@@ -0,0 +1,176 @@
+#include <cxxtest/TestSuite.h>
+#include <unistd.h>
+#include "../src/tombstone.h"
+
+class TombstoneTestSuite : public CxxTest::TestSuite
+{
+public:
+    void testTombstoneIncident_DefersRemoval()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        TombstoneStore store;
+        TS_ASSERT_EQUALS(attachTombstoneStore(&store, &system, 0.5, 4), 0);
+        ComplianceIncident incidents[4] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 8},
+                                           {DATA_PRIVACY, "Unencrypted backups", 5}};
+        for (int i = 0; i < 4; i++)
+        {
+            addLiveIncident(&store, incidents[i]);
+        }
+        TS_ASSERT_EQUALS(tombstoneIncident(&store, incidents[1]), 0);
+        TS_ASSERT_EQUALS(tombstoneIncident(&store, incidents[1]), -1);
+        TS_ASSERT_EQUALS(system.numIncidents, 4);
+        TS_ASSERT_EQUALS(isIncidentTombstoned(&store, 1), 1);
+        TS_ASSERT_EQUALS(countLiveIncidents(&store), 3);
+        TS_ASSERT_DELTA(calculateLiveAverageSeverity(&store), 20.0 / 3, 0.001);
+        TS_ASSERT_EQUALS(findHighestLiveSeverityIncident(&store).severity, 8);
+        detachTombstoneStore(&store);
+        TS_ASSERT_EQUALS(system.numIncidents, 3);
+        TS_ASSERT_EQUALS(strcmp(system.incidents[1].dataPrivacyIncident.description, "Unpaid overtime"), 0);
+    }
+    void testTombstone_HiddenFromCoreFunctions()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        TombstoneStore store;
+        attachTombstoneStore(&store, &system, 1.0, 4);
+        ComplianceIncident incident1 = {DATA_PRIVACY, "Leaked customer data", 9};
+        ComplianceIncident incident2 = {FINANCIAL_REGULATIONS, "Misreported earnings", 3};
+        addLiveIncident(&store, incident1);
+        addLiveIncident(&store, incident2);
+        TS_ASSERT_EQUALS(tombstoneIncident(&store, incident1), 0);
+        TS_ASSERT_EQUALS(system.numIncidents, 2);
+        TS_ASSERT_EQUALS(calculateAverageSeverity(system), 3.0);
+        TS_ASSERT_EQUALS(findHighestSeverityIncident(system).severity, 3);
+        TS_ASSERT_EQUALS(updateComplianceIncidentSeverity(&system, incident1, 5), -1);
+        TS_ASSERT_EQUALS(removeComplianceIncidentsOfType(&system, DATA_PRIVACY), 0);
+        TS_ASSERT_EQUALS(tombstoneIncident(&store, incident2), 0);
+        TS_ASSERT_EQUALS(calculateAverageSeverity(system), 0.0);
+        TS_ASSERT_EQUALS(strcmp(findHighestSeverityIncident(system).description, "No incidents in the system"), 0);
+        detachTombstoneStore(&store);
+        TS_ASSERT_EQUALS(system.numIncidents, 0);
+    }
+    void testTombstone_AnnouncedToListenersAsRemoval()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        TombstoneStore store;
+        attachTombstoneStore(&store, &system, 1.0, 4);
+        ComplianceIncident incident1 = {EMPLOYMENT_LAWS, "Unpaid overtime", 8};
+        ComplianceIncident incident2 = {EMPLOYMENT_LAWS, "Missing breaks", 4};
+        ComplianceIncident incident3 = {DATA_PRIVACY, "Unencrypted backups", 6};
+        addLiveIncident(&store, incident1);
+        addLiveIncident(&store, incident2);
+        addLiveIncident(&store, incident3);
+        TS_ASSERT_EQUALS(tombstoneIncidentAt(&store, 0), 0);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 1);
+        TS_ASSERT_EQUALS(bitmapNextPosition(indexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 0), 1);
+        TS_ASSERT_EQUALS(bitmapCardinality(indexedIncidentsWithSeverity(&index, 8, 8)), 0);
+
+        // Compaction only shifts the positions after the tombstone
+        TS_ASSERT_EQUALS(compactTombstones(&store, 4), 1);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 1);
+        TS_ASSERT_EQUALS(bitmapNextPosition(indexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 0), 0);
+        TS_ASSERT_EQUALS(bitmapNextPosition(indexedIncidentsOfType(&index, DATA_PRIVACY), 0), 1);
+        detachTombstoneStore(&store);
+        detachBitmapIndex(&index);
+    }
+    void testTombstones_CompactedInBudgetedSteps()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        TombstoneStore store;
+        attachTombstoneStore(&store, &system, 0.25, 2);
+        ComplianceIncident incidents[8] = {{DATA_PRIVACY, "Leaked customer data", 7},
+                                           {EMPLOYMENT_LAWS, "Unpaid overtime", 8},
+                                           {FINANCIAL_REGULATIONS, "Misreported earnings", 9},
+                                           {EMPLOYMENT_LAWS, "Missing breaks", 4},
+                                           {DATA_PRIVACY, "Unencrypted backups", 5},
+                                           {ENVIRONMENTAL_REGULATIONS, "Oil spill", 10},
+                                           {EMPLOYMENT_LAWS, "Unsafe scaffolding", 6},
+                                           {FINANCIAL_REGULATIONS, "Late filing", 3}};
+        for (int i = 0; i < 8; i++)
+        {
+            addLiveIncident(&store, incidents[i]);
+        }
+        // A type with three of the eight incidents reaches the threshold
+        TS_ASSERT_EQUALS(tombstoneIncidentsOfType(&store, EMPLOYMENT_LAWS), 3);
+        TS_ASSERT_EQUALS(system.numIncidents, 6);
+        TS_ASSERT_EQUALS(countLiveIncidents(&store), 5);
+        TS_ASSERT_EQUALS(compactTombstones(&store, 100), 1);
+        TS_ASSERT_EQUALS(system.numIncidents, 5);
+        for (int i = 0; i < system.numIncidents; i++)
+        {
+            TS_ASSERT_DIFFERS(system.incidents[i].dataPrivacyIncident.type, EMPLOYMENT_LAWS);
+            TS_ASSERT_EQUALS(isIncidentTombstoned(&store, i), 0);
+        }
+        detachTombstoneStore(&store);
+    }
+    void testAddLiveIncident_ReclaimsSpaceWhenFull()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        TombstoneStore store;
+        attachTombstoneStore(&store, &system, 1.0, 2);
+        for (int i = 0; i < 100; i++)
+        {
+            ComplianceIncident incident = {DATA_PRIVACY, "Repeated finding", i % 10 + 1};
+            addLiveIncident(&store, incident);
+        }
+        tombstoneIncidentAt(&store, 10);
+        tombstoneIncidentAt(&store, 20);
+        tombstoneIncidentAt(&store, 30);
+        ComplianceIncident incident = {FINANCIAL_REGULATIONS, "Late filing", 6};
+        addLiveIncident(&store, incident);
+        TS_ASSERT_EQUALS(system.numIncidents, 99);
+        TS_ASSERT_EQUALS(countLiveIncidents(&store), 98);
+        TS_ASSERT_EQUALS(isIncidentTombstoned(&store, 10), 1);
+        TS_ASSERT_EQUALS(system.incidents[98].dataPrivacyIncident.type, FINANCIAL_REGULATIONS);
+        detachTombstoneStore(&store);
+    }
+    void testTombstoneCompactor_CompactsInBackground()
+    {
+        ComplianceManagementSystem system;
+        system.numIncidents = 0;
+        IncidentBitmapIndex index;
+        attachBitmapIndex(&index, &system);
+        TombstoneStore store;
+        attachTombstoneStore(&store, &system, 0.1, 3);
+        ComplianceIncident overtime = {EMPLOYMENT_LAWS, "Unpaid overtime", 8};
+        ComplianceIncident backups = {DATA_PRIVACY, "Unencrypted backups", 5};
+        for (int i = 0; i < 25; i++)
+        {
+            addLiveIncident(&store, overtime);
+            addLiveIncident(&store, backups);
+        }
+        TS_ASSERT_EQUALS(startTombstoneCompactor(&store, 1), 0);
+        TS_ASSERT_EQUALS(startTombstoneCompactor(&store, 1), -1);
+
+        // Positions move on the compactor thread, so incidents are only tombstoned by identity
+        TS_ASSERT_EQUALS(tombstoneIncidentAt(&store, 0), -1);
+        for (int i = 0; i < 25; i++)
+        {
+            TS_ASSERT_EQUALS(tombstoneIncident(&store, overtime), 0);
+        }
+        for (int attempt = 0; attempt < 1000 && countStoredIncidents(&store) > 27; attempt++)
+        {
+            usleep(1000);
+        }
+
+        // The index changes on the compactor thread, so it is only read under the store lock
+        pthread_mutex_lock(&store.lock);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, EMPLOYMENT_LAWS), 0);
+        TS_ASSERT_EQUALS(countIndexedIncidentsOfType(&index, DATA_PRIVACY), 25);
+        pthread_mutex_unlock(&store.lock);
+        stopTombstoneCompactor(&store);
+        TS_ASSERT_EQUALS(countLiveIncidents(&store), 25);
+        TS_ASSERT_LESS_THAN_EQUALS(countStoredIncidents(&store), 27);
+        detachTombstoneStore(&store);
+        TS_ASSERT_EQUALS(system.numIncidents, 25);
+        detachBitmapIndex(&index);
+    }
+};
@@ -0,0 +1,134 @@
+#include <time.h>
+#include "tombstone.h"
+
+/*
+This function starts deferring the removals of a management system as tombstones. Incidents
+the system already holds as tombstones are picked up. Compaction starts once compactionThreshold
+of the incidents are tombstoned, for example 0.25 for a quarter, and reclaims at most
+compactionBudget tombstones per step. It returns 0 on success and -1 if no more listeners can
+be registered.
+*/
+int attachTombstoneStore(TombstoneStore *store, ComplianceManagementSystem *system, float compactionThreshold, int compactionBudget)
+{
+}
+
+/*
+This function stops deferring removals. The background compactor is stopped if it is running,
+every remaining tombstone is compacted so the system only holds live incidents, and the store
+stops listening to the system.
+*/
+void detachTombstoneStore(TombstoneStore *store)
+{
+}
+
+/*
+This function adds a compliance incident through a tombstone store. If the system is full and
+holds tombstones, a compaction step makes room first. The incident is then added with
+addComplianceIncident, and a compaction step is piggybacked on the write if the threshold has
+been reached and no background compactor is running.
+*/
+void addLiveIncident(TombstoneStore *store, ComplianceIncident incident)
+{
+}
+
+/*
+This function marks the compliance incident at a given position as removed with
+tombstoneComplianceIncidentAt, without moving any incident. From then on every function and
+listener of the system treats it as removed. Since a background compactor moves incidents
+between calls, a position read by the caller may no longer name the same incident, so the call
+is rejected while the compactor runs; tombstoneIncident finds the incident under the lock
+instead. It returns 0 on success and -1 if the position is out of range or already tombstoned,
+or if the compactor is running.
+*/
+int tombstoneIncidentAt(TombstoneStore *store, int index)
+{
+}
+
+/*
+This function marks the first live incident equal to the given one as removed, matching the
+same way removeComplianceIncident does. It returns 0 on success and -1 if no live incident
+matches.
+*/
+int tombstoneIncident(TombstoneStore *store, ComplianceIncident incident)
+{
+}
+
+/*
+This function marks all live compliance incidents of a certain type as removed and returns the
+number of incidents marked.
+*/
+int tombstoneIncidentsOfType(TombstoneStore *store, ComplianceType type)
+{
+}
+
+/*
+This function checks whether the incident at a given position is marked as removed. While a
+background compactor runs, the answer is only about whichever incident holds the position at
+the time of the call. It returns 1 if it is, and 0 if it is live or the position is out of range.
+*/
+int isIncidentTombstoned(TombstoneStore *store, int index)
+{
+}
+
+/*
+This function counts the incidents that are not marked as removed.
+*/
+int countLiveIncidents(TombstoneStore *store)
+{
+}
+
+/*
+This function counts the incidents the system holds, including the ones marked as removed but
+not yet compacted. It reads the count under the store lock, so it is safe to call while the
+background compactor runs.
+*/
+int countStoredIncidents(TombstoneStore *store)
+{
+}
+
+/*
+This function calculates the average severity of the incidents that are not marked as removed
+with calculateAverageSeverity, which skips tombstoned incidents, while holding the store lock.
+It returns 0 if there are no live incidents.
+*/
+float calculateLiveAverageSeverity(TombstoneStore *store)
+{
+}
+
+/*
+This function finds the live incident with the highest severity with findHighestSeverityIncident,
+which skips tombstoned incidents, while holding the store lock. If there are no live incidents,
+it returns the same empty incident as findHighestSeverityIncident.
+*/
+ComplianceIncident findHighestLiveSeverityIncident(TombstoneStore *store)
+{
+}
+
+/*
+This function runs one compaction step by hand, reclaiming up to budget tombstones regardless of
+the threshold. It returns the number of tombstones reclaimed.
+*/
+int compactTombstones(TombstoneStore *store, int budget)
+{
+}
+
+/*
+This function starts a background thread that runs a compaction step every intervalMilliseconds
+once the threshold has been reached. Writes stop piggybacking compaction while it runs. While the
+compactor runs, the system must only be changed through the tombstone store, and the system and
+every structure attached to it as a mutation listener must only be read while holding the store
+lock, since compaction changes them on the compactor thread. Positions are not stable between
+calls, so tombstoneIncidentAt is rejected. It returns 0 on success and -1 if the compactor is
+already running or the thread could not be started.
+*/
+int startTombstoneCompactor(TombstoneStore *store, int intervalMilliseconds)
+{
+}
+
+/*
+This function stops the background compactor and waits for its thread to finish. Writes
+piggyback compaction steps again afterwards.
+*/
+void stopTombstoneCompactor(TombstoneStore *store)
+{
+}
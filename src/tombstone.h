@@ -0,0 +1,73 @@
+#ifndef TOMBSTONE_H
+#define TOMBSTONE_H
+
+#include <pthread.h>
+#include "bitmapindex.h"
+
+// Background compaction:
+// - While the compactor runs, compaction moves incidents and notifies the listeners of the system
+//   on the compactor thread, holding the store lock. The system and everything attached to it as a
+//   listener (bitmap indexes, change feeds, escalation engines, severity histories, ...) must only
+//   be read while holding store->lock, and the system must only be changed through the store.
+// - Positions can move between any two calls, so tombstoneIncidentAt returns -1 while the
+//   compactor runs; tombstoneIncident identifies the incident under the lock instead.
+
+// Define struct for a management system whose removals are deferred as tombstones
+typedef struct
+{
+    ComplianceManagementSystem *system;
+    IncidentBitmap tombstones; // positions removed logically but not yet compacted
+    int numTombstones;
+    float compactionThreshold; // share of tombstoned incidents that triggers compaction
+    int compactionBudget;      // largest number of tombstones reclaimed per compaction step
+
+    // Background compactor, only used between startTombstoneCompactor and stopTombstoneCompactor
+    pthread_mutex_t lock;
+    pthread_t compactor;
+    int compactorRunning;
+    int compactorIntervalMilliseconds;
+} TombstoneStore;
+
+// Function to start deferring the removals of a management system as tombstones
+int attachTombstoneStore(TombstoneStore *store, ComplianceManagementSystem *system, float compactionThreshold, int compactionBudget);
+
+// Function to stop deferring removals, compacting every remaining tombstone
+void detachTombstoneStore(TombstoneStore *store);
+
+// Function to add a compliance incident through a tombstone store
+void addLiveIncident(TombstoneStore *store, ComplianceIncident incident);
+
+// Function to mark the compliance incident at a given position as removed
+int tombstoneIncidentAt(TombstoneStore *store, int index);
+
+// Function to mark a compliance incident as removed
+int tombstoneIncident(TombstoneStore *store, ComplianceIncident incident);
+
+// Function to mark all compliance incidents of a certain type as removed
+int tombstoneIncidentsOfType(TombstoneStore *store, ComplianceType type);
+
+// Function to check whether the incident at a given position is marked as removed
+int isIncidentTombstoned(TombstoneStore *store, int index);
+
+// Function to count the incidents that are not marked as removed
+int countLiveIncidents(TombstoneStore *store);
+
+// Function to count the incidents held by the system, including the ones marked as removed
+int countStoredIncidents(TombstoneStore *store);
+
+// Function to calculate the average severity of the incidents that are not marked as removed
+float calculateLiveAverageSeverity(TombstoneStore *store);
+
+// Function to find the incident with the highest severity that is not marked as removed
+ComplianceIncident findHighestLiveSeverityIncident(TombstoneStore *store);
+
+// Function to reclaim the space of up to budget tombstones
+int compactTombstones(TombstoneStore *store, int budget);
+
+// Function to start compacting tombstones from a background thread
+int startTombstoneCompactor(TombstoneStore *store, int intervalMilliseconds);
+
+// Function to stop the background compactor of a tombstone store
+void stopTombstoneCompactor(TombstoneStore *store);
+
+#endif